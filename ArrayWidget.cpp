@@ -1,51 +1,66 @@
 #include "ArrayWidget.h"
+#include "LinearPainter.h"
 #include <QPainter>
-#include <QPropertyAnimation>
-#include <QEasingCurve>
 #include <QTimer>
 #include <QMouseEvent>
+#include <QCoreApplication>
+#include <algorithm>
 #include <cmath>
 
+namespace {
+
+// 按值传参，避免 qBound 以引用方式使用类内静态常量
+int boundedInt(int low, int value, int high)
+{
+    return value < low ? low : (value > high ? high : value);
+}
+
+}
+
 ArrayWidget::ArrayWidget(QWidget *parent)
     : QWidget(parent)
-    , arraySize(0)
-    , m_animationProgress(0.0)
-    , animatingIndex(-1)
     , elementWidth(80)
     , elementHeight(60)
     , spacing(10)
+    , rowSpacing(ROW_SPACING)
     , elementsPerRow(1)
     , totalRows(1)
+    , startX(0)
+    , startY(0)
+    , contentHeight(0)
+    , layoutReady(false)
+    , overviewMode(false)
+    , detail(LinearPainter::FullDetail)
+    , layoutKeyCount(-1)
+    , layoutKeyWidth(0)
+    , layoutKeyHeight(0)
+    , backgroundValid(false)
 {
     setMinimumHeight(200);
-    animation = new QPropertyAnimation(this, "animationProgress", this);
-    animation->setDuration(500);
-    animation->setEasingCurve(QEasingCurve::OutCubic);
+    
+    // 元素过多时通过滚动条浏览，只绘制可视区域内的元素
+    vScrollBar = new QScrollBar(Qt::Vertical, this);
+    vScrollBar->setRange(0, 0);
+    vScrollBar->hide();
+    connect(vScrollBar, SIGNAL(valueChanged(int)), this, SLOT(onScrollValueChanged()));
+    
+    // 所有动画效果共用一个帧定时器，没有活跃效果时停止
+    frameTimer = new QTimer(this);
+    frameTimer->setInterval(FRAME_INTERVAL_MS);
+    connect(frameTimer, SIGNAL(timeout()), this, SLOT(onAnimationFrame()));
+    
+    updateTextLayout();
 }
 
 void ArrayWidget::initialize(int size)
 {
-    if (size <= 0) size = 5;  // 默认大小
-    if (size > 30) size = 30;  // 限制最大大小
-    
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
     // 停止所有动画
-    if (animation) {
-        animation->stop();
-    }
-    
-    elements.clear();
-    elements.resize(size);
+    timeline.clear();
+    frameTimer->stop();
     
     // 初始化为空位置，确保所有状态都被清除
-    for (int i = 0; i < size; ++i) {
-        elements[i] = ArrayElement();
-        elements[i].isHighlighted = false;
-        elements[i].isAnimating = false;
-    }
-    
-    arraySize = size;
-    animatingIndex = -1;  // 重置动画索引
-    m_animationProgress = 0.0;  // 重置动画进度
+    model.reset(size);
     
     updateLayout();
     update();
@@ -55,32 +70,12 @@ void ArrayWidget::initialize(int size)
 
 void ArrayWidget::initialize(const QStringList &values)
 {
-    int size = values.size();
-    if (size <= 0) size = 5;  // 默认大小
-    if (size > 30) size = 30;  // 限制最大大小
-    
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
     // 停止所有动画
-    if (animation) {
-        animation->stop();
-    }
-    
-    elements.clear();
-    elements.resize(size);
-    
-    // 初始化元素，确保所有状态都被清除
-    for (int i = 0; i < size; ++i) {
-        if (i < values.size()) {
-            elements[i] = ArrayElement(values[i]);
-        } else {
-            elements[i] = ArrayElement();  // 空位置
-        }
-        elements[i].isHighlighted = false;  // 确保不高亮
-        elements[i].isAnimating = false;
-    }
+    timeline.clear();
+    frameTimer->stop();
     
-    arraySize = size;
-    animatingIndex = -1;  // 重置动画索引
-    m_animationProgress = 0.0;  // 重置动画进度
+    model.reset(values);
     
     updateLayout();
     update();
@@ -88,162 +83,331 @@ void ArrayWidget::initialize(const QStringList &values)
     repaint();
 }
 
-QStringList ArrayWidget::getValues() const
+bool ArrayWidget::insertElement(int index, const QString &value)
 {
-    QStringList result;
-    for (int i = 0; i < elements.size(); ++i) {
-        if (!elements[i].isEmpty) {
-            result << elements[i].value;
-        }
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 数组插入：在索引index之后插入（index = -1 表示在开头插入）
+    // 如果目标位置为空，直接填充；否则插入新位置
+    int oldSize = model.size();
+    int insertPos = model.insert(index, value);
+    if (insertPos < 0) {
+        return false;
     }
-    return result;
+    
+    if (model.size() != oldSize) {
+        // 后续元素整体后移，进行中的效果跟随元素移动，立即更新布局和界面
+        timeline.shiftIndices(insertPos, 1);
+        updateLayout();
+        update();
+    }
+    
+    startEffect(insertPos, INSERT_HIGHLIGHT_MS, true);
+    return true;
 }
 
-int ArrayWidget::getElementCount() const
+bool ArrayWidget::deleteElement(int index)
 {
-    int count = 0;
-    for (int i = 0; i < elements.size(); ++i) {
-        if (!elements[i].isEmpty) {
-            count++;
-        }
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 数组删除：立即清空该位置（位置保留），空位高亮提示删除位置
+    bool popped = false;
+    if (!eraseSlot(index, popped)) {
+        return false;  // 越界或该位置已经为空
     }
-    return count;
+    
+    if (popped) {
+        // 环形模式下两端出队，位置已经移除，没有可高亮的空位；索引标签整体变化
+        updateLayout();
+        update();
+        return true;
+    }
+    startEffect(index, EDIT_HIGHLIGHT_MS, true);
+    return true;
 }
 
-bool ArrayWidget::insertElement(int index, const QString &value)
+bool ArrayWidget::eraseSlot(int index, bool &popped)
 {
-    // 数组插入：在索引index之后插入
-    // index = -1 表示在开头插入
-    // index >= 0 表示在索引index之后插入
-    // 如果目标位置为空，直接填充；否则插入新位置
-    
-    if (index < -1) {
+    int oldSize = model.size();
+    if (!model.erase(index)) {
         return false;
     }
     
-    int insertPos;
-    bool fillEmpty = false;
-    
-    if (index == -1) {
-        // 在开头插入
-        insertPos = 0;
-        // 检查位置0是否为空
-        if (insertPos < arraySize && elements[insertPos].isEmpty) {
-            fillEmpty = true;
-        }
-    } else if (index >= arraySize) {
-        // 在末尾插入
-        insertPos = arraySize;
-    } else {
-        // 在索引index之后插入
-        insertPos = index + 1;
-        // 检查目标位置是否为空
-        if (insertPos < arraySize && elements[insertPos].isEmpty) {
-            fillEmpty = true;
-        }
+    popped = model.size() != oldSize;
+    if (popped) {
+        timeline.remove(index);
+        timeline.shiftIndices(index + 1, -1);
     }
-    
-    if (fillEmpty) {
-        // 直接填充空位置
-        elements[insertPos].value = value;
-        elements[insertPos].isEmpty = false;
-        elements[insertPos].isHighlighted = true;
-    } else {
-        // 插入新位置（动态扩展）
-        // 限制最大元素数量
-        if (arraySize >= 30) {
-            return false;
-        }
-        
-        elements.insert(insertPos, ArrayElement(value));
-        elements[insertPos].isHighlighted = true;
-        arraySize = elements.size();  // 更新数组大小
+    return true;
+}
+
+void ArrayWidget::setRingMode(bool enabled)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    if (model.isRingMode() == enabled) {
+        return;
     }
     
-    // 立即更新布局和界面
+    // 切换时存储可能重新整理，逻辑索引不变，只需重新布局
+    model.setRingMode(enabled);
     updateLayout();
     update();
-    
-    animateElement(insertPos);
-    
-    QTimer::singleShot(600, this, [this, insertPos]() {
-        elements[insertPos].isHighlighted = false;
-        update();
-    });
-    
-    return true;
 }
 
-bool ArrayWidget::deleteElement(int index)
+void ArrayWidget::setOverviewMode(bool enabled)
 {
-    // 数组删除：清空该位置，但位置保留
-    if (index < 0 || index >= arraySize) {
-        return false;
+    if (overviewMode == enabled) {
+        return;
     }
     
-    if (elements[index].isEmpty) {
-        return false;  // 该位置已经为空
+    // 元素数量和尺寸都没变，需要清除上次的求解结果
+    overviewMode = enabled;
+    layoutKeyCount = -1;
+    updateLayout();
+    update();
+}
+
+bool ArrayWidget::modifyElement(int index, const QString &value)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    if (model.isEmpty(index)) {
+        return false;  // 越界或该位置为空，不能修改
     }
     
-    elements[index].isHighlighted = true;
-    update();
+    model.modify(index, value);
+    startEffect(index, EDIT_HIGHLIGHT_MS, true);
+    return true;
+}
+
+int ArrayWidget::applyBatch(const LinearOpList &ops)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int applied = 0;
+    int focusIndex = -1;
     
-    animateElement(index);
+    int i = 0;
+    while (i < ops.size()) {
+        const LinearOp &op = ops[i];
+        
+        if (op.type == LinearOp::Insert) {
+            // 连续插入在上一个插入位置之后的操作合并为一次区间插入，后续元素只移动一次
+            int insertPos = op.index < 0 ? 0 : qMin(op.index + 1, model.size());
+            QStringList run;
+            run << op.value;
+            int next = i + 1;
+            while (next < ops.size() && ops[next].type == LinearOp::Insert
+                   && ops[next].index == insertPos + run.size() - 1) {
+                run << ops[next].value;
+                ++next;
+            }
+            
+            int inserted = insertRun(op.index, run);
+            if (inserted > 0) {
+                focusIndex = insertPos;
+            }
+            applied += inserted;
+            i = next;
+            continue;
+        }
+        
+        if (op.type == LinearOp::Delete) {
+            bool popped = false;
+            if (eraseSlot(op.index, popped)) {
+                if (!popped) {
+                    timeline.start(op.index, EDIT_HIGHLIGHT_MS, false);
+                    focusIndex = op.index;
+                }
+                ++applied;
+            }
+        } else if (!model.isEmpty(op.index)) {
+            model.modify(op.index, op.value);
+            timeline.start(op.index, EDIT_HIGHLIGHT_MS, false);
+            focusIndex = op.index;
+            ++applied;
+        }
+        ++i;
+    }
     
-    QTimer::singleShot(500, this, [this, index]() {
-        elements[index].isEmpty = true;
-        elements[index].value = "";
-        elements[index].isHighlighted = false;
+    if (applied > 0) {
+        finishBatch(focusIndex);
+    }
+    return applied;
+}
+
+int ArrayWidget::insertRange(int index, const QStringList &values)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int inserted = insertRun(index, values);
+    if (inserted > 0) {
+        finishBatch(index < 0 ? 0 : qMin(index + 1, model.size() - 1));
+    }
+    return inserted;
+}
+
+int ArrayWidget::appendValues(const QStringList &values)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int appended = model.append(values);
+    if (appended > 0) {
+        updateLayout();
         update();
-    });
-    
-    return true;
+    }
+    return appended;
 }
 
-bool ArrayWidget::modifyElement(int index, const QString &value)
+int ArrayWidget::deleteRange(int index, int count)
 {
-    if (index < 0 || index >= arraySize) {
-        return false;
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 先记下区间内有元素的位置用于高亮，哪些位置两端出队由模型决定
+    QVector<int> filled;
+    for (int i = qMax(0, index); i < qMin(index + count, model.size()); ++i) {
+        if (!model.isEmpty(i)) {
+            filled << i;
+        }
     }
     
-    if (elements[index].isEmpty) {
-        return false;  // 该位置为空，不能修改
+    int oldSize = model.size();
+    int frontPopped = 0;
+    int erased = model.eraseRange(index, count, &frontPopped);
+    if (erased == 0) {
+        return 0;
     }
     
-    elements[index].isHighlighted = true;
-    update();
+    // 出队的位置连同进行中的效果一起移除，开头出队后其余效果前移
+    int backBegin = model.size() + frontPopped;  // 原索引中从末尾出队的第一个位置
+    for (int i = backBegin; i < oldSize; ++i) {
+        timeline.remove(i);
+    }
+    for (int i = 0; i < frontPopped; ++i) {
+        timeline.remove(i);
+    }
+    if (frontPopped > 0) {
+        timeline.shiftIndices(frontPopped, -frontPopped);
+    }
     
-    animateElement(index);
+    // 只清空的位置保留，高亮提示
+    int focusIndex = -1;
+    for (int i : filled) {
+        if (i < frontPopped || i >= backBegin) {
+            continue;
+        }
+        timeline.start(i - frontPopped, EDIT_HIGHLIGHT_MS, false);
+        if (focusIndex < 0) {
+            focusIndex = i - frontPopped;
+        }
+    }
+    finishBatch(focusIndex);
+    return erased;
+}
+
+int ArrayWidget::insertRun(int index, const QStringList &values)
+{
+    int oldSize = model.size();
+    int insertPos = index < 0 ? 0 : qMin(index + 1, oldSize);
+    int inserted = model.insertRange(index, values);
+    
+    // 新增的位置使后续元素后移，进行中的效果跟随移动
+    timeline.shiftIndices(insertPos, model.size() - oldSize);
+    for (int k = 0; k < inserted; ++k) {
+        timeline.start(insertPos + k, INSERT_HIGHLIGHT_MS, false);
+    }
+    return inserted;
+}
+
+void ArrayWidget::finishBatch(int focusIndex)
+{
+    // 整批操作只布局一次，受影响的元素一起高亮，只有最后一个弹起
+    updateLayout();
+    update();
+    if (focusIndex < 0) {
+        // 环形模式下整批都是两端出队，没有要弹起的元素
+        if (!timeline.isEmpty() && !frameTimer->isActive()) {
+            frameTimer->start();
+        }
+        return;
+    }
+    startEffect(focusIndex, 0, true);
+}
+
+void ArrayWidget::startEffect(int index, int highlightMs, bool bounce)
+{
+    if (bounce) {
+        ensureIndexVisible(index);
+    }
+    timeline.start(index, highlightMs, bounce);
+    markElementDirty(index);
     
-    QTimer::singleShot(500, this, [this, index, value]() {
-        elements[index].value = value;
-        elements[index].isHighlighted = false;
+    // 动画关闭时时间线保持为空，不需要启动帧定时器
+    if (!timeline.isEmpty() && !frameTimer->isActive()) {
+        frameTimer->start();
+    }
+}
+
+void ArrayWidget::setAnimationsEnabled(bool enabled)
+{
+    timeline.setEnabled(enabled);
+    if (!enabled) {
+        frameTimer->stop();
+        invalidateBackground();
         update();
-    });
+    }
+}
+
+void ArrayWidget::onAnimationFrame()
+{
+    hud.markAnimationFrame();
     
-    return true;
+    // 弹起或高亮刚结束的元素重绘为静止状态，仍在弹起的元素只重绘其所在区域
+    QVector<int> settled = timeline.advance();
+    for (int index : settled) {
+        markElementDirty(index);
+    }
+    QVector<int> bouncing = raisedIndices();
+    for (int index : bouncing) {
+        update(elementDirtyRect(index));
+    }
+    if (hud.isEnabled()) {
+        update(hud.overlayRect(rect()));
+    }
+    
+    if (timeline.isEmpty()) {
+        frameTimer->stop();
+    }
 }
 
-void ArrayWidget::setAnimationProgress(qreal progress)
+void ArrayWidget::resetCostCounters()
 {
-    m_animationProgress = progress;
-    // 动画过程中持续更新界面
-    update();
+    lastOperationCost = OpCost();
+    totalOperationCost = OpCost();
 }
 
-void ArrayWidget::animateElement(int index)
+void ArrayWidget::freezeAnimationClock(qint64 offsetMs)
 {
-    animatingIndex = index;
-    animation->stop();
-    animation->setStartValue(0.0);
-    animation->setEndValue(1.0);
-    animation->start();
+    timeline.freezeClock(offsetMs);
+}
+
+void ArrayWidget::setHudVisible(bool visible)
+{
+    hud.setEnabled(visible);
+    update();
 }
 
 void ArrayWidget::updateLayout()
 {
+    PerfHud::Scope layoutScope(hud, PerfHud::LayoutMetric);
+    invalidateBackground();
+    
     // 如果组件还没有正确的尺寸，延迟更新
+    // 网格按物理槽位排列，环形模式下包括未使用的槽位
+    int arraySize = model.capacity();
     if (width() <= 0 || height() <= 0 || arraySize <= 0) {
+        contentHeight = 0;
+        layoutKeyCount = -1;
+        updateScrollBar();
+        return;
+    }
+    
+    // 元素数量和组件尺寸都没变时沿用上次的求解结果
+    if (arraySize == layoutKeyCount && width() == layoutKeyWidth && height() == layoutKeyHeight) {
+        layoutReady = true;
         return;
     }
     
@@ -251,81 +415,204 @@ void ArrayWidget::updateLayout()
     int availableWidth = width() - 2 * HORIZONTAL_MARGIN;
     int availableHeight = height() - 2 * VERTICAL_MARGIN;
     
-    // 计算每行能放多少个元素（尝试不同的元素大小）
-    int bestElementsPerRow = 1;
-    int bestElementWidth = MIN_ELEMENT_WIDTH;
-    int bestElementHeight = MIN_ELEMENT_HEIGHT;
-    int bestSpacing = MIN_SPACING;
-    
-    // 尝试找到最佳的布局配置
-    for (int testWidth = MAX_ELEMENT_WIDTH; testWidth >= MIN_ELEMENT_WIDTH; testWidth -= 5) {
-        for (int testSpacing = MIN_SPACING; testSpacing <= 15; testSpacing += 2) {
-            int cols = (availableWidth + testSpacing) / (testWidth + testSpacing);
-            if (cols < 1) cols = 1;
-            
-            int rows = (arraySize + cols - 1) / cols;  // 向上取整
-            int testHeight = (availableHeight - (rows - 1) * 25) / rows;  // 减去行间距（包括索引空间）
-            
-            if (testHeight >= MIN_ELEMENT_HEIGHT && testHeight <= MAX_ELEMENT_HEIGHT) {
-                if (cols * rows >= arraySize) {
-                    bestElementsPerRow = cols;
-                    bestElementWidth = testWidth;
-                    bestElementHeight = testHeight;
-                    bestSpacing = testSpacing;
-                    break;
-                }
-            }
+    // 直接求解：由可用高度得到最多能放的行数，由行数得到每行至少需要的列数，
+    // 再由列数得到能放下的最大元素宽度
+    int maxRows = qMax(1, (availableHeight + ROW_SPACING) / (MIN_ELEMENT_HEIGHT + ROW_SPACING));
+    int neededCols = (arraySize + maxRows - 1) / maxRows;
+    int fitWidth = (availableWidth + MIN_SPACING) / neededCols - MIN_SPACING;
+    
+    spacing = MIN_SPACING;
+    rowSpacing = ROW_SPACING;
+    detail = LinearPainter::FullDetail;
+    if (fitWidth < MIN_ELEMENT_WIDTH && overviewMode) {
+        // 概览：不设最小尺寸，整个数组缩小到可视区域内
+        solveOverviewLayout(arraySize, availableWidth, availableHeight);
+    } else if (fitWidth < MIN_ELEMENT_WIDTH) {
+        // 最小尺寸也放不下：使用最小尺寸并启用滚动（为滚动条让出宽度）
+        availableWidth -= vScrollBar->sizeHint().width();
+        elementWidth = MIN_ELEMENT_WIDTH;
+        elementHeight = MIN_ELEMENT_HEIGHT;
+        elementsPerRow = qMax(1, (availableWidth + spacing) / (elementWidth + spacing));
+        totalRows = (arraySize + elementsPerRow - 1) / elementsPerRow;
+    } else {
+        elementWidth = boundedInt(MIN_ELEMENT_WIDTH, fitWidth, MAX_ELEMENT_WIDTH);
+        elementsPerRow = qMax(1, (availableWidth + spacing) / (elementWidth + spacing));
+        totalRows = (arraySize + elementsPerRow - 1) / elementsPerRow;
+        elementHeight = boundedInt(MIN_ELEMENT_HEIGHT, (availableHeight - (totalRows - 1) * ROW_SPACING) / totalRows,
+                                   MAX_ELEMENT_HEIGHT);
+        
+        // 剩余宽度分给元素间距
+        if (elementsPerRow > 1) {
+            spacing = boundedInt(MIN_SPACING, (availableWidth - elementsPerRow * elementWidth) / (elementsPerRow - 1),
+                                 MAX_SPACING);
         }
-        if (bestElementsPerRow > 1) break;
     }
     
-    // 如果没找到合适的，使用最小尺寸
-    if (bestElementsPerRow == 1) {
-        bestElementWidth = qMin(MAX_ELEMENT_WIDTH, availableWidth - MIN_SPACING);
-        bestElementHeight = qMin(MAX_ELEMENT_HEIGHT, availableHeight);
-        bestSpacing = MIN_SPACING;
-        bestElementsPerRow = (availableWidth + bestSpacing) / (bestElementWidth + bestSpacing);
-        if (bestElementsPerRow < 1) bestElementsPerRow = 1;
+    // 计算总宽度和总高度（用于居中）
+    int totalWidth = elementsPerRow * elementWidth + (elementsPerRow - 1) * spacing;
+    int totalHeight = totalRows * elementHeight + (totalRows - 1) * rowSpacing;
+    
+    // 位置不再逐个保存，由 elementPosition() 按网格参数计算
+    startX = HORIZONTAL_MARGIN + (availableWidth - totalWidth) / 2;
+    startY = VERTICAL_MARGIN + qMax(0, (availableHeight - totalHeight) / 2);
+    contentHeight = totalHeight + 2 * VERTICAL_MARGIN;
+    
+    layoutKeyCount = arraySize;
+    layoutKeyWidth = width();
+    layoutKeyHeight = height();
+    layoutReady = true;
+    updateTextLayout();
+    updateScrollBar();
+}
+
+void ArrayWidget::solveOverviewLayout(int count, int availableWidth, int availableHeight)
+{
+    // 格子取正方形：先由每个元素平均分到的面积估计间距，再逐步缩小到全部放得下
+    // （完整细节的格子还要额外的行间距放索引，不能直接由面积求出）；细节层级由格子边长决定
+    int pitch = qMax(1, int(std::sqrt(qreal(availableWidth) * availableHeight / count)));
+    for (;; --pitch) {
+        int gap = LinearPainter::overviewGap(pitch);
+        int cell = pitch - gap;
+        detail = LinearPainter::detailFor(cell, cell);
+        rowSpacing = gap;
+        if (detail == LinearPainter::FullDetail) {
+            rowSpacing = ROW_SPACING;
+        }
+        elementsPerRow = qMax(1, (availableWidth + gap) / pitch);
+        totalRows = (count + elementsPerRow - 1) / elementsPerRow;
+        if (totalRows * (cell + rowSpacing) - rowSpacing <= availableHeight || pitch == 1) {
+            elementWidth = cell;
+            elementHeight = cell;
+            spacing = gap;
+            break;
+        }
     }
     
-    // 更新成员变量
-    elementWidth = bestElementWidth;
-    elementHeight = bestElementHeight;
-    spacing = bestSpacing;
-    elementsPerRow = bestElementsPerRow;
-    totalRows = (arraySize + elementsPerRow - 1) / elementsPerRow;
+    if (totalRows > availableHeight) {
+        // 每个元素一个像素也放不下：保持一个像素并启用滚动（为滚动条让出宽度）
+        elementsPerRow = qMax(1, availableWidth - vScrollBar->sizeHint().width());
+        totalRows = (count + elementsPerRow - 1) / elementsPerRow;
+    }
+}
+
+void ArrayWidget::ensureLayout()
+{
+    if (!layoutReady) {
+        updateLayout();
+    }
+}
+
+void ArrayWidget::updateTextLayout()
+{
+    // 字体只随元素大小变化，整个组件共用；尺寸不变时缓存保持有效
+    valueTexts.setFont(QFont("Arial", qMax(8, qMin(14, elementWidth / 6)), QFont::Bold));
+    valueTexts.setMaxWidth(elementWidth - 2 * TEXT_PADDING);
+    emptyTexts.setFont(QFont("Arial", qMax(8, qMin(12, elementWidth / 7))));
+    indexTexts.setFont(QFont("Arial", 10));
+    indexTexts.setMaxWidth(elementWidth);
+}
+
+void ArrayWidget::updateScrollBar()
+{
+    int overflow = contentHeight - height();
+    if (overflow > 0) {
+        int barWidth = vScrollBar->sizeHint().width();
+        vScrollBar->setGeometry(width() - barWidth, 0, barWidth, height());
+        vScrollBar->setRange(0, overflow);
+        vScrollBar->setPageStep(height());
+        vScrollBar->setSingleStep(elementHeight + rowSpacing);
+        vScrollBar->show();
+    } else {
+        vScrollBar->setRange(0, 0);
+        vScrollBar->hide();
+    }
+}
+
+QPointF ArrayWidget::elementPosition(int index) const
+{
+    return slotPosition(model.physicalIndex(index));
+}
+
+QPointF ArrayWidget::slotPosition(int slot) const
+{
+    int row = slot / elementsPerRow;
+    int col = slot % elementsPerRow;
     
-    // 计算总宽度和总高度（用于居中）
-    int totalWidth = elementsPerRow * elementWidth + (elementsPerRow - 1) * spacing;
-    int totalHeight = totalRows * elementHeight + (totalRows - 1) * 25;  // 行间距25（为索引留出空间）
+    int x = startX + col * (elementWidth + spacing);
+    int y = startY + row * (elementHeight + rowSpacing) - vScrollBar->value();
+    return QPointF(x, y);
+}
+
+int ArrayWidget::elementAt(const QPointF &pos) const
+{
+    if (model.capacity() <= 0) {
+        return -1;
+    }
     
-    int startX = HORIZONTAL_MARGIN + (availableWidth - totalWidth) / 2;
-    int startY = VERTICAL_MARGIN + (availableHeight - totalHeight) / 2;
+    // 网格是均匀的：先换算成内容坐标，再直接求出行列
+    int columnPitch = elementWidth + spacing;
+    int rowPitch = elementHeight + rowSpacing;
+    qreal x = pos.x() - startX;
+    qreal y = pos.y() + vScrollBar->value() - startY;
+    if (x < 0 || y < 0) {
+        return -1;
+    }
     
-    // 确保elements数组大小与arraySize一致
-    if (elements.size() < arraySize) {
-        elements.resize(arraySize);
+    int col = int(x) / columnPitch;
+    int row = int(y) / rowPitch;
+    if (col >= elementsPerRow) {
+        return -1;
     }
     
-    // 计算每个元素的位置（支持换行）
-    for (int i = 0; i < arraySize; ++i) {
-        int row = i / elementsPerRow;
-        int col = i % elementsPerRow;
-        
-        int x = startX + col * (elementWidth + spacing);
-        int y = startY + row * (elementHeight + 25);  // 行间距25（为索引留出空间）
-        
-        QPointF basePos(x, y);
-        elements[i].targetPosition = basePos;
-        elements[i].position = basePos;
+    // 落在元素之间的间距或行间距里
+    if (x - col * columnPitch > elementWidth || y - row * rowPitch > elementHeight) {
+        return -1;
+    }
+    
+    // 未使用的槽位没有逻辑索引
+    return model.logicalIndex(row * elementsPerRow + col);
+}
+
+void ArrayWidget::visibleRange(int &first, int &last) const
+{
+    // 范围按物理槽位计算；每行在内容坐标中占据 [行顶 - 索引标签高度, 行顶 + 元素高度]
+    int rowPitch = elementHeight + rowSpacing;
+    int viewTop = vScrollBar->value();
+    int viewBottom = viewTop + height();
+    
+    int firstRow = qMax(0, (viewTop - startY - elementHeight) / rowPitch);
+    int lastRow = qMax(0, (viewBottom - startY + INDEX_LABEL_HEIGHT) / rowPitch);
+    
+    first = qMin(model.capacity(), firstRow * elementsPerRow);
+    last = qMin(model.capacity(), (lastRow + 1) * elementsPerRow);
+}
+
+void ArrayWidget::ensureIndexVisible(int index)
+{
+    ensureLayout();
+    if (vScrollBar->maximum() <= 0 || !model.isValidIndex(index)) {
+        return;
+    }
+    
+    int row = model.physicalIndex(index) / elementsPerRow;
+    int rowTop = startY + row * (elementHeight + rowSpacing) - INDEX_LABEL_HEIGHT;
+    int rowBottom = rowTop + INDEX_LABEL_HEIGHT + elementHeight;
+    int viewTop = vScrollBar->value();
+    
+    if (rowTop < viewTop) {
+        vScrollBar->setValue(rowTop - VERTICAL_MARGIN);
+    } else if (rowBottom > viewTop + height()) {
+        vScrollBar->setValue(rowBottom - height() + VERTICAL_MARGIN);
     }
 }
 
 void ArrayWidget::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
-    updateLayout();
-    update();  // 确保窗口大小变化时立即刷新
+    // 拖动窗口时会连续收到多次 resizeEvent，这里只标记布局失效，
+    // 由下一次 paintEvent 统一计算，每帧最多求解一次
+    layoutReady = false;
+    update();
 }
 
 void ArrayWidget::showEvent(QShowEvent *event)
@@ -336,117 +623,293 @@ void ArrayWidget::showEvent(QShowEvent *event)
     update();
 }
 
+void ArrayWidget::wheelEvent(QWheelEvent *event)
+{
+    // 滚轮事件交给滚动条处理
+    if (vScrollBar->maximum() > 0) {
+        QCoreApplication::sendEvent(vScrollBar, event);
+        return;
+    }
+    QWidget::wheelEvent(event);
+}
+
 void ArrayWidget::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
-    
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    if (hud.isEnabled()) {
+        qint64 dirtyPixels = 0;
+        for (const QRect &r : event->region()) {
+            dirtyPixels += qint64(r.width()) * r.height();
+        }
+        hud.setRepaintArea(dirtyPixels, qint64(width()) * height());
+    }
     
-    // 绘制背景
-    painter.fillRect(rect(), QColor(240, 240, 240));
+    {
+        PerfHud::Scope paintScope(hud, PerfHud::PaintMetric);
+        paintContent(painter);
+    }
     
+    // 性能面板不计入绘制耗时
+    if (hud.isEnabled()) {
+        hud.paint(painter, rect());
+    }
+}
+
+void ArrayWidget::paintContent(QPainter &painter)
+{
     // 如果数组未初始化，不绘制任何内容
-    if (arraySize <= 0) {
+    if (model.capacity() <= 0) {
+        painter.fillRect(rect(), QColor(240, 240, 240));
         return;
     }
     
     // 确保布局已更新
-    if (elements.isEmpty() || elements[0].targetPosition.isNull()) {
-        updateLayout();
+    ensureLayout();
+    
+    // 静态内容（背景、非弹起元素、索引）缓存在图层中，
+    // 动画过程中每帧只需贴图一次并重绘正在弹起的元素
+    QVector<int> bouncing = raisedIndices();
+    std::sort(bouncing.begin(), bouncing.end());
+    qreal ratio = devicePixelRatioF();
+    QSize cacheSize = size() * ratio;
+    if (!backgroundValid || backgroundCache.size() != cacheSize) {
+        backgroundCache = QPixmap(cacheSize);
+        backgroundCache.setDevicePixelRatio(ratio);
+        QPainter cachePainter(&backgroundCache);
+        renderBackground(cachePainter);
+        backgroundSkipped = bouncing;
+        backgroundValid = true;
+        backgroundDirty = QRegion();
+    } else {
+        // 开始或结束弹起的元素所在区域需要重新生成（屏幕上的重绘已由动画帧安排）
+        if (backgroundSkipped != bouncing) {
+            for (int index : backgroundSkipped) {
+                backgroundDirty += elementDirtyRect(index);
+            }
+            for (int index : bouncing) {
+                backgroundDirty += elementDirtyRect(index);
+            }
+            backgroundSkipped = bouncing;
+        }
+        // 只重绘图层中的脏区域
+        if (!backgroundDirty.isEmpty()) {
+            QPainter cachePainter(&backgroundCache);
+            cachePainter.setClipRegion(backgroundDirty);
+            renderBackground(cachePainter);
+            backgroundDirty = QRegion();
+        }
     }
+    painter.drawPixmap(0, 0, backgroundCache);
     
-    // 先绘制所有元素，然后绘制索引（避免索引被遮挡）
-    for (int i = 0; i < arraySize; ++i) {
-        QPointF pos = elements[i].targetPosition;
-        
-        // 计算动画位置
-        QPointF currentPos = pos;
-        if (i == animatingIndex && animation->state() == QAbstractAnimation::Running) {
-            qreal scale = 1.0 + 0.2 * sin(m_animationProgress * 3.14159);
-            currentPos.setY(pos.y() - 10 * (1.0 - qAbs(m_animationProgress - 0.5) * 2));
-        }
-        
-        // 绘制元素框（使用动态计算的尺寸）
-        QRectF elementRect(currentPos.x(), currentPos.y(), elementWidth, elementHeight);
-        
-        // 选择颜色
-        QColor bgColor;
-        QColor borderColor;
-        
-        if (elements[i].isEmpty) {
-            bgColor = QColor(255, 255, 255);
-            borderColor = QColor(200, 200, 200);
-        } else if (elements[i].isHighlighted) {
-            bgColor = QColor(100, 200, 255);
-            borderColor = QColor(50, 150, 255);
-        } else {
-            bgColor = QColor(200, 230, 255);
-            borderColor = QColor(100, 180, 255);
+    if (!bouncing.isEmpty()) {
+        painter.setRenderHint(QPainter::Antialiasing);
+    }
+    for (int index : bouncing) {
+        if (!model.isValidIndex(index)) {
+            continue;
         }
         
-        // 绘制元素
-        QPen pen(borderColor, 2);
-        painter.setPen(pen);
-        painter.setBrush(bgColor);
-        painter.drawRoundedRect(elementRect, 5, 5);
-        
-        // 绘制值（根据元素大小调整字体）
-        if (!elements[i].isEmpty) {
-            painter.setPen(QColor(0, 0, 0));
-            // 根据元素大小动态调整字体
-            int fontSize = qMax(8, qMin(14, elementWidth / 6));
-            QFont valueFont("Arial", fontSize, QFont::Bold);
-            painter.setFont(valueFont);
-            painter.drawText(elementRect, Qt::AlignCenter, elements[i].value);
-        } else {
-            painter.setPen(QColor(180, 180, 180));
-            int fontSize = qMax(8, qMin(12, elementWidth / 7));
-            QFont valueFont("Arial", fontSize);
-            painter.setFont(valueFont);
-            painter.drawText(elementRect, Qt::AlignCenter, "空");
+        // 计算动画位置
+        QPointF pos = elementPosition(index);
+        pos.setY(pos.y() - BOUNCE_HEIGHT * timeline.bounceHeight(index));
+        paintElement(painter, index, pos);
+        // 索引绘制在元素之上，与静态图层保持一致
+        paintIndexLabel(painter, index);
+    }
+}
+
+void ArrayWidget::renderBackground(QPainter &painter)
+{
+    // 只绘制与可视区域相交的元素
+    int first = 0;
+    int last = 0;
+    visibleRange(first, last);
+    if (hud.isEnabled()) {
+        hud.setElementCounts(last - first, model.capacity() - (last - first));
+        hud.setValuePoolStats(ValuePool::shared().stats());
+    }
+    
+    // 色带图像本身包括背景，不需要先填充
+    if (detail == LinearPainter::StripDetail) {
+        renderStrip(painter, first, last);
+        return;
+    }
+    
+    // 绘制背景
+    painter.fillRect(rect(), QColor(240, 240, 240));
+    if (detail == LinearPainter::ReducedDetail) {
+        renderReduced(painter, first, last);
+        return;
+    }
+    painter.setRenderHint(QPainter::Antialiasing);
+    
+    // 先绘制所有元素，然后绘制索引（避免索引被遮挡）
+    for (int slot = first; slot < last; ++slot) {
+        int index = model.logicalIndex(slot);
+        if (index < 0) {
+            // 环形缓冲区中未使用的槽位：只画空框，不显示文字和索引
+            LinearPainter::drawCell(painter, QRectF(slotPosition(slot), QSizeF(elementWidth, elementHeight)),
+                                    LinearPainter::EmptyCell);
+        } else if (!timeline.isBouncing(index)) {
+            paintElement(painter, index, slotPosition(slot));
         }
     }
     
     // 最后绘制索引标签（在元素上方，避免被下一行遮挡）
-    QFont indexFont("Arial", 10);
-    painter.setFont(indexFont);
-    painter.setPen(QColor(100, 100, 100));
+    for (int slot = first; slot < last; ++slot) {
+        int index = model.logicalIndex(slot);
+        if (index >= 0) {
+            paintIndexLabel(painter, index);
+        }
+    }
+}
+
+void ArrayWidget::renderReduced(QPainter &painter, int first, int last)
+{
+    // 格子只有几个像素宽，文字和索引放不下，抗锯齿和圆角也看不出来
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    for (int slot = first; slot < last; ++slot) {
+        int index = model.logicalIndex(slot);
+        LinearPainter::CellStyle style = index < 0 ? LinearPainter::EmptyCell : cellStyle(index);
+        LinearPainter::drawPlainCell(painter, QRect(slotPosition(slot).toPoint(), QSize(elementWidth, elementHeight)),
+                                     style);
+    }
+}
+
+void ArrayWidget::renderStrip(QPainter &painter, int first, int last)
+{
+    if (stripImage.size() != size()) {
+        stripImage = QImage(size(), QImage::Format_RGB32);
+    }
+    stripImage.fill(QColor(240, 240, 240));
     
-    for (int i = 0; i < arraySize; ++i) {
-        QPointF pos = elements[i].targetPosition;
-        
-        // 计算动画位置（索引使用原始位置，不受动画影响）
-        QPointF indexPos = pos;
-        
-        // 将索引放在元素上方，避免被下一行遮挡
-        QRectF indexRect(indexPos.x(), indexPos.y() - 18, elementWidth, 15);
-        if (indexRect.bottom() < height() && indexRect.top() >= 0) {
-            painter.drawText(indexRect, Qt::AlignCenter, QString::number(i));
+    // 每种样式的颜色只换算一次；可视范围总是从行首开始，逐行写入扫描线
+    QRgb palette[LinearPainter::HeadCell + 1];
+    for (int style = 0; style <= LinearPainter::HeadCell; ++style) {
+        palette[style] = LinearPainter::stripColor(LinearPainter::CellStyle(style));
+    }
+    QVector<QRgb> colors(elementsPerRow);
+    for (int rowStart = first; rowStart < last; rowStart += elementsPerRow) {
+        int count = qMin(elementsPerRow, last - rowStart);
+        for (int i = 0; i < count; ++i) {
+            int index = model.logicalIndex(rowStart + i);
+            colors[i] = palette[index < 0 ? LinearPainter::EmptyCell : cellStyle(index)];
         }
+        QPointF pos = slotPosition(rowStart);
+        LinearPainter::fillStripRow(stripImage, int(pos.x()), int(pos.y()), colors.constData(), count,
+                                    elementWidth, elementHeight, elementWidth + spacing);
     }
+    painter.drawImage(0, 0, stripImage);
+}
+
+LinearPainter::CellStyle ArrayWidget::cellStyle(int index) const
+{
+    bool highlighted = timeline.isHighlighted(index);
+    if (model.isEmpty(index)) {
+        return highlighted ? LinearPainter::EmptyHighlightedCell : LinearPainter::EmptyCell;
+    }
+    return highlighted ? LinearPainter::HighlightedCell : LinearPainter::NormalCell;
+}
+
+QVector<int> ArrayWidget::raisedIndices() const
+{
+    // 简化和色带层级的格子太小，弹起会盖住相邻行，只以高亮颜色画在图层中
+    if (detail != LinearPainter::FullDetail) {
+        return QVector<int>();
+    }
+    return timeline.bouncingIndices();
+}
+
+void ArrayWidget::paintElement(QPainter &painter, int index, const QPointF &pos)
+{
+    // 绘制元素框（使用动态计算的尺寸）
+    QRectF elementRect(pos.x(), pos.y(), elementWidth, elementHeight);
+    LinearPainter::CellStyle style = cellStyle(index);
+    LinearPainter::drawCell(painter, elementRect, style);
+    
+    // 绘制值（字体和排版结果由缓存提供，过长的值以省略号结尾）
+    if (!model.isEmpty(index)) {
+        painter.setPen(QColor(0, 0, 0));
+        valueTexts.draw(painter, elementRect, model.value(index));
+    } else {
+        painter.setPen(QColor(180, 180, 180));
+        emptyTexts.draw(painter, elementRect, QStringLiteral("空"));
+    }
+}
+
+void ArrayWidget::paintIndexLabel(QPainter &painter, int index)
+{
+    // 环形模式下在首尾元素的索引后标出头、尾
+    QString label = QString::number(index);
+    bool marked = false;
+    if (model.isRingMode()) {
+        if (index == 0) {
+            label += QStringLiteral(" 头");
+            marked = true;
+        }
+        if (index == model.size() - 1) {
+            label += QStringLiteral(" 尾");
+            marked = true;
+        }
+    }
+    painter.setPen(marked ? QColor(200, 100, 0) : QColor(100, 100, 100));
+    
+    // 索引使用原始位置，不受动画影响，放在元素上方避免被下一行遮挡
+    QPointF indexPos = elementPosition(index);
+    QRectF indexRect(indexPos.x(), indexPos.y() - INDEX_LABEL_HEIGHT, elementWidth, 15);
+    if (indexRect.bottom() < height() && indexRect.top() >= 0) {
+        indexTexts.draw(painter, indexRect, label);
+    }
+}
+
+void ArrayWidget::invalidateBackground()
+{
+    backgroundValid = false;
+}
+
+QRect ArrayWidget::elementDirtyRect(int index) const
+{
+    // 覆盖元素本身、上方的索引标签和弹起动画的偏移，外扩边框画笔宽度
+    QPointF pos = elementPosition(index);
+    QRectF area(pos.x(), pos.y() - INDEX_LABEL_HEIGHT - BOUNCE_HEIGHT,
+                elementWidth, elementHeight + INDEX_LABEL_HEIGHT + BOUNCE_HEIGHT);
+    return area.adjusted(-2, -2, 2, 2).toAlignedRect();
+}
+
+void ArrayWidget::markElementDirty(int index)
+{
+    // 不可见的元素不在图层中，滚动到它时会整体重绘
+    int first = 0;
+    int last = 0;
+    visibleRange(first, last);
+    int slot = model.physicalIndex(index);
+    if (!model.isValidIndex(index) || slot < first || slot >= last) {
+        return;
+    }
+    QRect dirty = elementDirtyRect(index);
+    backgroundDirty += dirty;
+    update(dirty);
+}
+
+void ArrayWidget::onScrollValueChanged()
+{
+    invalidateBackground();
+    update();
 }
 
 void ArrayWidget::mousePressEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::LeftButton) {
-        QPointF clickPos = event->pos();
+        ensureLayout();
         
-        // 检查点击了哪个元素（使用动态尺寸）
-        for (int i = 0; i < arraySize; ++i) {
-            QRectF elementRect(elements[i].targetPosition.x(), 
-                              elements[i].targetPosition.y(), 
-                              elementWidth, elementHeight);
-            
-            if (elementRect.contains(clickPos)) {
-                // 只有非空位置才能点击
-                if (!elements[i].isEmpty) {
-                    emit elementClicked(i);
-                }
-                return;
+        // 只有非空位置才能点击
+        int index = elementAt(event->pos());
+        if (index >= 0) {
+            if (!model.isEmpty(index)) {
+                emit elementClicked(index);
             }
+            return;
         }
     }
     QWidget::mousePressEvent(event);
 }
-
@@ -3,7 +3,6 @@
 
 #include <QWidget>
 #include <QPainter>
-#include <QPropertyAnimation>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QVector>
@@ -11,23 +10,22 @@
 #include <QStringList>
 #include <QMouseEvent>
 #include <QShowEvent>
-
-struct ArrayElement {
-    QString value;
-    bool isEmpty;
-    bool isHighlighted;
-    bool isAnimating;
-    QPointF position;
-    QPointF targetPosition;
-    
-    ArrayElement() : isEmpty(true), isHighlighted(false), isAnimating(false) {}
-    ArrayElement(const QString &val) : value(val), isEmpty(false), isHighlighted(false), isAnimating(false) {}
-};
+#include <QWheelEvent>
+#include <QScrollBar>
+#include <QPixmap>
+#include <QImage>
+#include <QRegion>
+#include <QTimer>
+#include "ArrayModel.h"
+#include "AnimationTimeline.h"
+#include "LinearPainter.h"
+#include "LinearOp.h"
+#include "PerfHud.h"
+#include "TextLayoutCache.h"
 
 class ArrayWidget : public QWidget
 {
     Q_OBJECT
-    Q_PROPERTY(qreal animationProgress READ animationProgress WRITE setAnimationProgress)
 
 signals:
     void elementClicked(int index);
@@ -35,48 +33,134 @@ signals:
 public:
     explicit ArrayWidget(QWidget *parent = nullptr);
     
+    static const int DEFAULT_MAX_ELEMENTS = ArrayModel::DEFAULT_MAX_ELEMENTS;  // 默认元素上限
+    
     void initialize(int size);
     void initialize(const QStringList &values);
     bool insertElement(int index, const QString &value);  // 在索引index之后插入（动态数组）
-    bool deleteElement(int index);  // 删除元素，位置保留为空（固定数组）
+    bool deleteElement(int index);  // 删除元素，位置保留为空（固定数组）；环形模式下两端出队
     bool modifyElement(int index, const QString &value);
-    int getSize() const { return arraySize; }  // 返回数组容量
-    int getElementCount() const;  // 返回实际元素数量
-    QStringList getValues() const;
     
-    qreal animationProgress() const { return m_animationProgress; }
-    void setAnimationProgress(qreal progress);
+    // 批量操作：先全部修改模型，再统一布局一次、播放一次高亮动画，返回成功的操作数
+    int applyBatch(const LinearOpList &ops);
+    int insertRange(int index, const QStringList &values);
+    int deleteRange(int index, int count);
+    int appendValues(const QStringList &values);  // 分块加载时在末尾追加，不播放动画，返回追加个数
+    int getSize() const { return model.size(); }  // 返回数组容量
+    int getElementCount() const { return model.count(); }  // 返回实际元素数量
+    QStringList getValues() const { return model.values(); }
+    QString getValue(int index) const { return model.value(index); }  // 空位置返回空字符串
+    void setMaxElements(int limit) { model.setMaxElements(limit); }  // 设置元素数量上限
+    int maxElements() const { return model.maxElements(); }
+    const ArrayModel &arrayModel() const { return model; }
+    // 环形缓冲区模式：按物理槽位画成一条格子带，首尾元素的索引标出头、尾，未使用的槽位画为空框
+    void setRingMode(bool enabled);
+    bool isRingMode() const { return model.isRingMode(); }
+    // 概览模式：元素多到需要滚动时不再限制最小尺寸，整个数组缩小到可视区域内，
+    // 按每个元素分到的像素依次降为简化方框和色带（见 LinearPainter::DetailLevel）
+    void setOverviewMode(bool enabled);
+    bool isOverviewMode() const { return overviewMode; }
+    LinearPainter::DetailLevel detailLevel() const { return detail; }
+    void setHudVisible(bool visible);  // 显示/隐藏性能统计面板
+    void setAnimationsEnabled(bool enabled);  // 关闭后操作立即生效，不播放高亮和弹起（如高速回放）
+    bool animationsEnabled() const { return timeline.isEnabled(); }
+    bool isHudVisible() const { return hud.isEnabled(); }
+    // 开销计数：最近一次操作（批量操作算一次）和自上次清零以来的累计，只统计经由本组件接口的操作
+    OpCost lastCost() const { return lastOperationCost; }
+    OpCost totalCost() const { return totalOperationCost; }
+    void resetCostCounters();
+    void freezeAnimationClock(qint64 offsetMs);  // 定格动画进度，见 AnimationTimeline::freezeClock（离屏渲染基准用）
+    void invalidateBackground();  // 结构、尺寸或滚动变化后调用；离屏渲染基准每帧调用以测量完整的一帧
+
+private slots:
+    void onScrollValueChanged();
+    void onAnimationFrame();  // 帧定时器回调：推进时间线并重绘受影响的元素
 
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     void showEvent(QShowEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
 
 private:
     void updateLayout();
-    void animateElement(int index);
+    void solveOverviewLayout(int count, int availableWidth, int availableHeight);
+    void ensureLayout();  // 布局失效（如窗口缩放后）时立即求解
+    void paintContent(QPainter &painter);
+    void renderBackground(QPainter &painter);  // 绘制除正在弹起的元素以外的全部可见内容
+    void renderReduced(QPainter &painter, int first, int last);  // 简化层级：不抗锯齿的方框
+    void renderStrip(QPainter &painter, int first, int last);  // 色带层级：写入 stripImage 后整体贴图
+    void paintElement(QPainter &painter, int index, const QPointF &pos);
+    void paintIndexLabel(QPainter &painter, int index);
+    LinearPainter::CellStyle cellStyle(int index) const;
+    QVector<int> raisedIndices() const;  // 需要在图层之上单独绘制的弹起元素，只有完整细节层级才有
+    void updateTextLayout();  // 元素尺寸变化后更新共用字体
+    QRect elementDirtyRect(int index) const;  // 元素变化时需要重绘的区域（组件坐标）
+    void markElementDirty(int index);  // 单个元素的高亮或值变化后调用，只重绘该区域
+    void updateScrollBar();
+    void startEffect(int index, int highlightMs, bool bounce);  // 在时间线上为元素开始高亮/弹起效果
+    int insertRun(int index, const QStringList &values);  // 区间插入并登记高亮，不布局
+    bool eraseSlot(int index, bool &popped);  // 删除并修正时间线，popped 表示位置被移除（两端出队）
+    void finishBatch(int focusIndex);  // 批量操作后的布局和动画
+    void ensureIndexVisible(int index);
+    QPointF elementPosition(int index) const;  // 根据网格参数计算元素位置（已扣除滚动偏移）
+    QPointF slotPosition(int slot) const;  // 物理槽位的位置，非环形模式下与索引相同
+    int elementAt(const QPointF &pos) const;  // 组件坐标处的元素索引，不在任何元素上时返回 -1
+    void visibleRange(int &first, int &last) const;  // 可视区域内的物理槽位范围 [first, last)
     
-    QVector<ArrayElement> elements;
-    int arraySize;  // 数组容量（固定大小）
-    qreal m_animationProgress;
-    QPropertyAnimation *animation;
-    int animatingIndex;
+    ArrayModel model;  // 数据模型，本组件只负责绘制和动画
+    AnimationTimeline timeline;  // 高亮和弹起效果，模型修改总是立即提交
+    QTimer *frameTimer;
     
     // 动态计算的尺寸
     int elementWidth;
     int elementHeight;
     int spacing;
+    int rowSpacing;  // 完整细节时为 ROW_SPACING（为索引留出空间），概览的小格子与列间隙相同
     int elementsPerRow;  // 每行元素数量
     int totalRows;  // 总行数
+    int startX;  // 网格左上角（内容坐标）
+    int startY;
+    int contentHeight;  // 内容总高度，超出可视区域时启用滚动
+    bool layoutReady;
+    bool overviewMode;
+    LinearPainter::DetailLevel detail;  // 由布局求解得到
+    int layoutKeyCount;  // 上次求解时的元素数量和组件尺寸，用于复用结果
+    int layoutKeyWidth;
+    int layoutKeyHeight;
+    QScrollBar *vScrollBar;
+    PerfHud hud;
+    OpCost lastOperationCost;
+    OpCost totalOperationCost;
+    
+    // 静态内容图层：结构、尺寸或滚动变化时整体重绘，单个元素变化时只重绘脏区域
+    QPixmap backgroundCache;
+    bool backgroundValid;
+    QVector<int> backgroundSkipped;  // 图层中未绘制的（正在弹起的）元素，已排序
+    QRegion backgroundDirty;  // 图层中待重绘的区域
+    QImage stripImage;  // 色带层级的绘制目标，尺寸不变时复用
+    
+    // 文本排版缓存（值、空位提示、索引各用一种字体）
+    TextLayoutCache valueTexts;
+    TextLayoutCache emptyTexts;
+    TextLayoutCache indexTexts;
     
     static const int MIN_ELEMENT_WIDTH = 50;
     static const int MAX_ELEMENT_WIDTH = 120;
     static const int MIN_ELEMENT_HEIGHT = 50;
     static const int MAX_ELEMENT_HEIGHT = 80;
     static const int MIN_SPACING = 5;
+    static const int MAX_SPACING = 15;
     static const int HORIZONTAL_MARGIN = 20;
     static const int VERTICAL_MARGIN = 20;
+    static const int ROW_SPACING = 25;  // 完整细节的行间距（为索引留出空间）
+    static const int INDEX_LABEL_HEIGHT = 18;  // 索引标签位于元素上方的高度
+    static const int BOUNCE_HEIGHT = 10;  // 动画时元素弹起的最大高度
+    static const int TEXT_PADDING = 4;  // 值文本与元素边框的最小距离
+    static const int INSERT_HIGHLIGHT_MS = 600;  // 插入后的高亮时长
+    static const int EDIT_HIGHLIGHT_MS = 500;  // 删除、修改后的高亮时长
+    static const int FRAME_INTERVAL_MS = 16;  // 动画帧间隔
 };
 
 #endif // ARRAYWIDGET_H
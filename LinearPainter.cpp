@@ -0,0 +1,132 @@
+#include "LinearPainter.h"
+#include <QPolygonF>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+void cellColors(LinearPainter::CellStyle style, QColor &bgColor, QColor &borderColor)
+{
+    switch (style) {
+    case LinearPainter::HighlightedCell:
+        bgColor = QColor(100, 200, 255);
+        borderColor = QColor(50, 150, 255);
+        break;
+    case LinearPainter::EmptyCell:
+        bgColor = QColor(255, 255, 255);
+        borderColor = QColor(200, 200, 200);
+        break;
+    case LinearPainter::EmptyHighlightedCell:
+        // 刚删除的空位用高亮边框提示
+        bgColor = QColor(255, 255, 255);
+        borderColor = QColor(50, 150, 255);
+        break;
+    case LinearPainter::HeadCell:
+        bgColor = QColor(255, 220, 200);
+        borderColor = QColor(255, 150, 100);
+        break;
+    default:
+        bgColor = QColor(200, 230, 255);
+        borderColor = QColor(100, 180, 255);
+        break;
+    }
+}
+
+}
+
+void LinearPainter::drawCell(QPainter &painter, const QRectF &rect, CellStyle style)
+{
+    QColor bgColor;
+    QColor borderColor;
+    cellColors(style, bgColor, borderColor);
+
+    painter.setPen(QPen(borderColor, 2));
+    painter.setBrush(bgColor);
+    painter.drawRoundedRect(rect, 5, 5);
+}
+
+void LinearPainter::drawArrow(QPainter &painter, const QPointF &from, const QPointF &to)
+{
+    QColor color(100, 100, 100);
+    painter.setPen(QPen(color, 2));
+    painter.drawLine(from, to);
+
+    qreal dx = to.x() - from.x();
+    qreal dy = to.y() - from.y();
+    qreal length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0) {
+        return;
+    }
+
+    // 头部长 8、半宽 4：沿线段方向后退 8，再向两侧各偏 4
+    qreal ux = dx / length;
+    qreal uy = dy / length;
+    QPolygonF head;
+    head << to
+         << QPointF(to.x() - 8 * ux - 4 * uy, to.y() - 8 * uy + 4 * ux)
+         << QPointF(to.x() - 8 * ux + 4 * uy, to.y() - 8 * uy - 4 * ux);
+    painter.setBrush(color);
+    painter.drawPolygon(head);
+}
+
+LinearPainter::DetailLevel LinearPainter::detailFor(int cellWidth, int cellHeight)
+{
+    if (cellWidth >= FULL_DETAIL_MIN_WIDTH && cellHeight >= FULL_DETAIL_MIN_HEIGHT) {
+        return FullDetail;
+    }
+    if (cellWidth >= REDUCED_DETAIL_MIN_SIZE && cellHeight >= REDUCED_DETAIL_MIN_SIZE) {
+        return ReducedDetail;
+    }
+    return StripDetail;
+}
+
+int LinearPainter::overviewGap(int pitch)
+{
+    if (pitch >= 8) {
+        return pitch / 8;
+    }
+    return pitch >= 3 ? 1 : 0;
+}
+
+void LinearPainter::drawPlainCell(QPainter &painter, const QRect &rect, CellStyle style)
+{
+    QColor bgColor;
+    QColor borderColor;
+    cellColors(style, bgColor, borderColor);
+
+    painter.fillRect(rect, borderColor);
+    if (rect.width() > 2 && rect.height() > 2) {
+        painter.fillRect(rect.adjusted(1, 1, -1, -1), bgColor);
+    }
+}
+
+QRgb LinearPainter::stripColor(CellStyle style)
+{
+    QColor bgColor;
+    QColor borderColor;
+    cellColors(style, bgColor, borderColor);
+    return borderColor.rgb();
+}
+
+void LinearPainter::fillStripRow(QImage &image, int left, int top, const QRgb *colors, int count,
+                                 int cellWidth, int cellHeight, int columnPitch)
+{
+    int firstLine = qMax(0, top);
+    int lastLine = qMin(image.height(), top + cellHeight);
+    if (firstLine >= lastLine) {
+        return;
+    }
+
+    QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(firstLine));
+    for (int i = 0; i < count; ++i) {
+        int x0 = qMax(0, left + i * columnPitch);
+        int x1 = qMin(image.width(), left + i * columnPitch + cellWidth);
+        for (int x = x0; x < x1; ++x) {
+            line[x] = colors[i];
+        }
+    }
+
+    for (int y = firstLine + 1; y < lastLine; ++y) {
+        std::memcpy(image.scanLine(y), line, image.bytesPerLine());
+    }
+}
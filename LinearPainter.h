@@ -0,0 +1,50 @@
+#ifndef LINEARPAINTER_H
+#define LINEARPAINTER_H
+
+#include <QPainter>
+#include <QPointF>
+#include <QRectF>
+#include <QImage>
+
+// 各可视化组件共用的图元：元素格子和节点之间的箭头，保证不同结构的配色和样式一致
+class LinearPainter
+{
+public:
+    enum CellStyle {
+        NormalCell,
+        HighlightedCell,
+        EmptyCell,             // 没有值的位置（数组删除后的空位、展开链表节点的空闲槽位）
+        EmptyHighlightedCell,  // 刚被清空的位置
+        HeadCell               // 链表头节点
+    };
+
+    // 元素密集时的绘制细节层级，由每个元素可用的像素决定（见 detailFor）
+    enum DetailLevel {
+        FullDetail,     // 圆角格子、值文本、索引和箭头
+        ReducedDetail,  // 不抗锯齿的方框，不画文字和索引
+        StripDetail     // 每个元素一个色块，逐行写入 QImage 扫描线后整体贴图
+    };
+
+    static const int FULL_DETAIL_MIN_WIDTH = 24;  // 放得下一个字符和边框的最小格子
+    static const int FULL_DETAIL_MIN_HEIGHT = 16;
+    static const int REDUCED_DETAIL_MIN_SIZE = 4;  // 更小的格子边框与底色已经分不清
+
+    // 只绘制格子的边框和底色，文本由调用方通过各自的 TextLayoutCache 绘制
+    static void drawCell(QPainter &painter, const QRectF &rect, CellStyle style);
+    // 从 from 指向 to 的箭头，箭头头部沿线段方向
+    static void drawArrow(QPainter &painter, const QPointF &from, const QPointF &to);
+
+    static DetailLevel detailFor(int cellWidth, int cellHeight);
+    // 概览网格中相邻格子的间隙，pitch 为格子加间隙的总宽度；色带层级的小格子之间没有间隙
+    static int overviewGap(int pitch);
+    // 简化层级的格子：1 像素边框加底色，只用 fillRect，不抗锯齿
+    static void drawPlainCell(QPainter &painter, const QRect &rect, CellStyle style);
+    // 色带层级的颜色，取各样式的边框色，比底色更容易区分
+    static QRgb stripColor(CellStyle style);
+    // 把一行格子写入 image：只填写第一条扫描线，其余 cellHeight - 1 条整行复制；超出图像的部分跳过
+    // image 须为 32 位格式并已填充背景，同一扫描线上不能有其他内容
+    static void fillStripRow(QImage &image, int left, int top, const QRgb *colors, int count,
+                             int cellWidth, int cellHeight, int columnPitch);
+};
+
+#endif // LINEARPAINTER_H
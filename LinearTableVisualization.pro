@@ -8,16 +8,49 @@ QMAKE_CXXFLAGS += /utf-8
 TARGET = LinearTableVisualization
 TEMPLATE = app
 
+# 数据模型核心（只依赖 QtCore）
+INCLUDEPATH += $$PWD/core
+
 SOURCES += \
     main.cpp \
     MainWindow.cpp \
     ArrayWidget.cpp \
-    LinkedListWidget.cpp
+    LinkedListWidget.cpp \
+    UnrolledListWidget.cpp \
+    LinearPainter.cpp \
+    PerfHud.cpp \
+    TextLayoutCache.cpp \
+    TraceReplayer.cpp \
+    core/ArrayModel.cpp \
+    core/LinkedListModel.cpp \
+    core/AnimationTimeline.cpp \
+    core/OperationTrace.cpp \
+    core/BulkImporter.cpp \
+    core/InputTokenizer.cpp \
+    core/ValuePool.cpp \
+    core/UnrolledListModel.cpp
 
 HEADERS += \
     MainWindow.h \
     ArrayWidget.h \
-    LinkedListWidget.h
+    LinkedListWidget.h \
+    UnrolledListWidget.h \
+    LinearPainter.h \
+    PerfHud.h \
+    TextLayoutCache.h \
+    TraceReplayer.h \
+    core/ArrayModel.h \
+    core/LinkedListModel.h \
+    core/AnimationTimeline.h \
+    core/OperationTrace.h \
+    core/BulkImporter.h \
+    core/InputTokenizer.h \
+    core/ValuePool.h \
+    core/UnrolledListModel.h \
+    core/LinearOp.h \
+    core/NodePool.h \
+    core/PackedFlags.h \
+    core/OpCost.h
 
 # 设置输出目录
 DESTDIR = $$PWD/bin
@@ -1,98 +1,70 @@
 #include "LinkedListWidget.h"
+#include "LinearPainter.h"
 #include <QPainter>
-#include <QPropertyAnimation>
-#include <QEasingCurve>
 #include <QTimer>
 #include <QMouseEvent>
+#include <QCoreApplication>
+#include <algorithm>
 #include <cmath>
 
+namespace {
+
+// 按值传参，避免 qBound 以引用方式使用类内静态常量
+int boundedInt(int low, int value, int high)
+{
+    return value < low ? low : (value > high ? high : value);
+}
+
+}
+
 LinkedListWidget::LinkedListWidget(QWidget *parent)
     : QWidget(parent)
-    , head(nullptr)
-    , listSize(0)
-    , m_animationProgress(0.0)
-    , animatingIndex(-1)
     , nodeWidth(100)
     , nodeHeight(60)
     , arrowLength(40)
     , spacing(20)
+    , rowSpacing(ROW_SPACING)
     , nodesPerRow(1)
     , totalRows(1)
+    , startX(0)
+    , startY(0)
+    , contentHeight(0)
+    , layoutReady(false)
+    , overviewMode(false)
+    , detail(LinearPainter::FullDetail)
+    , layoutKeyCount(-1)
+    , layoutKeyWidth(0)
+    , layoutKeyHeight(0)
+    , backgroundValid(false)
 {
     setMinimumHeight(200);
-    animation = new QPropertyAnimation(this, "animationProgress", this);
-    animation->setDuration(500);
-    animation->setEasingCurve(QEasingCurve::OutCubic);
+    
+    // 节点过多时通过滚动条浏览，只绘制可视区域内的节点
+    vScrollBar = new QScrollBar(Qt::Vertical, this);
+    vScrollBar->setRange(0, 0);
+    vScrollBar->hide();
+    connect(vScrollBar, SIGNAL(valueChanged(int)), this, SLOT(onScrollValueChanged()));
+    
+    // 所有动画效果共用一个帧定时器，没有活跃效果时停止
+    frameTimer = new QTimer(this);
+    frameTimer->setInterval(FRAME_INTERVAL_MS);
+    connect(frameTimer, SIGNAL(timeout()), this, SLOT(onAnimationFrame()));
+    
+    updateTextLayout();
 }
 
 LinkedListWidget::~LinkedListWidget()
 {
-    clearList();
-}
-
-void LinkedListWidget::clearList()
-{
-    ListNode *current = head;
-    while (current) {
-        ListNode *next = current->next;
-        delete current;
-        current = next;
-    }
-    head = nullptr;
-    listSize = 0;
-}
-
-ListNode* LinkedListWidget::getNodeAt(int index)
-{
-    // 返回索引为index的实际节点（不包括头节点）
-    // index从0开始，对应第一个实际节点
-    if (index < 0 || !head) {
-        return nullptr;
-    }
-    
-    ListNode *current = head->next;  // 从第一个实际节点开始
-    int count = 0;
-    while (current && count < index) {
-        current = current->next;
-        count++;
-    }
-    return current;
 }
 
 void LinkedListWidget::initialize(int size)
 {
-    clearList();
-    
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
     // 停止所有动画
-    if (animation) {
-        animation->stop();
-    }
-    
-    if (size <= 0) {
-        animatingIndex = -1;
-        m_animationProgress = 0.0;
-        update();
-        return;
-    }
-    
-    head = new ListNode();
-    head->value = "头节点";
-    head->index = -1;
-    head->isHighlighted = false;  // 确保不高亮
+    timeline.clear();
+    frameTimer->stop();
     
-    ListNode *current = head;
-    for (int i = 0; i < size; ++i) {
-        ListNode *newNode = new ListNode();
-        newNode->value = QString("节点%1").arg(i);
-        newNode->index = i;
-        newNode->isHighlighted = false;  // 确保不高亮
-        current->next = newNode;
-        current = newNode;
-    }
-    
-    listSize = size;
-    animatingIndex = -1;  // 重置动画索引
-    m_animationProgress = 0.0;  // 重置动画进度
+    model.reset(size);
     
     updateLayout();
     update();
@@ -100,218 +72,247 @@ void LinkedListWidget::initialize(int size)
 
 void LinkedListWidget::initialize(const QStringList &values)
 {
-    clearList();
-    
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
     // 停止所有动画
-    if (animation) {
-        animation->stop();
-    }
-    
-    if (values.isEmpty()) {
-        animatingIndex = -1;
-        m_animationProgress = 0.0;
-        update();
-        return;
-    }
+    timeline.clear();
+    frameTimer->stop();
     
-    head = new ListNode();
-    head->value = "头节点";
-    head->index = -1;
-    head->isHighlighted = false;  // 确保不高亮
-    
-    ListNode *current = head;
-    for (int i = 0; i < values.size(); ++i) {
-        ListNode *newNode = new ListNode();
-        newNode->value = values[i];
-        newNode->index = i;
-        newNode->isHighlighted = false;  // 确保不高亮
-        current->next = newNode;
-        current = newNode;
-    }
-    
-    listSize = values.size();
-    animatingIndex = -1;  // 重置动画索引
-    m_animationProgress = 0.0;  // 重置动画进度
+    model.reset(values);
     
     updateLayout();
     update();
 }
 
-QStringList LinkedListWidget::getValues() const
-{
-    QStringList result;
-    ListNode *current = head;
-    if (current) {
-        current = current->next; // 跳过头节点
-    }
-    while (current) {
-        result << current->value;
-        current = current->next;
-    }
-    return result;
-}
-
-void LinkedListWidget::addElement(int index, const QString &value)
+bool LinkedListWidget::addElement(int index, const QString &value)
 {
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
     // 支持在任意位置插入，包括在末尾之后
     // index = -1: 在开头插入
     // index >= 0: 在索引index之后插入（如果index >= listSize，则在末尾插入）
-    
-    if (index < -1) {
-        return;
-    }
-    
-    ListNode *newNode = new ListNode();
-    newNode->value = value;
-    newNode->isHighlighted = true;
-    
-    ListNode *prev = nullptr;
-    int insertIndex = 0;
-    
-    if (index == -1) {
-        // 在开头插入
-        prev = head;
-        insertIndex = 0;
-    } else if (index >= listSize) {
-        // 在末尾插入
-        prev = getNodeAt(listSize - 1);
-        if (!prev) {
-            // 如果链表为空，使用head作为前驱
-            prev = head;
-        }
-        insertIndex = listSize;
-    } else {
-        // 在索引index之后插入
-        prev = getNodeAt(index);
-        if (!prev) {
-            delete newNode;
-            return;
-        }
-        insertIndex = index + 1;
+    int insertIndex = model.insertAfter(index, value);
+    if (insertIndex < 0) {
+        return false;
     }
     
-    newNode->index = insertIndex;
-    newNode->next = prev->next;
-    prev->next = newNode;
+    // 后续节点索引加一，进行中的效果跟随节点移动；立即更新布局和界面
+    timeline.shiftIndices(insertIndex, 1);
+    updateLayout();
+    update();
     
-    // 更新后续节点的索引
-    ListNode *current = newNode->next;
-    int count = insertIndex + 1;
-    while (current) {
-        current->index = count++;
-        current = current->next;
+    startEffect(insertIndex, INSERT_HIGHLIGHT_MS, true);
+    return true;
+}
+
+bool LinkedListWidget::deleteElement(int index)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 立即删除节点，后继节点补位并弹起提示删除位置
+    if (!model.removeAt(index)) {
+        return false;
     }
     
-    listSize++;
-    // 立即更新布局和界面
+    timeline.remove(index);
+    timeline.shiftIndices(index + 1, -1);
     updateLayout();
     update();
     
-    animateNode(insertIndex);
-    
-    QTimer::singleShot(600, this, [this, insertIndex]() {
-        ListNode *node = getNodeAt(insertIndex);
-        if (node) {
-            node->isHighlighted = false;
-        }
-        update();
-    });
+    if (index < model.size()) {
+        startEffect(index, 0, true);
+    }
+    return true;
 }
 
-bool LinkedListWidget::deleteElement(int index)
+bool LinkedListWidget::modifyElement(int index, const QString &value)
 {
-    if (index < 0 || index >= listSize || !head || !head->next) {
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    if (!model.modify(index, value)) {
         return false;
     }
     
-    // 找到要删除节点的前驱节点
-    ListNode *prev = nullptr;
-    if (index == 0) {
-        // 删除第一个节点，前驱是head
-        prev = head;
-    } else {
-        // 删除其他节点，前驱是index-1的节点
-        prev = getNodeAt(index - 1);
+    startEffect(index, EDIT_HIGHLIGHT_MS, true);
+    return true;
+}
+
+int LinkedListWidget::applyBatch(const LinearOpList &ops)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int applied = 0;
+    int focusIndex = -1;
+    
+    for (const LinearOp &op : ops) {
+        if (op.type == LinearOp::Insert) {
+            int insertIndex = model.insertAfter(op.index, op.value);
+            if (insertIndex < 0) {
+                continue;
+            }
+            timeline.shiftIndices(insertIndex, 1);
+            timeline.start(insertIndex, INSERT_HIGHLIGHT_MS, false);
+            focusIndex = insertIndex;
+        } else if (op.type == LinearOp::Delete) {
+            if (!model.removeAt(op.index)) {
+                continue;
+            }
+            timeline.remove(op.index);
+            timeline.shiftIndices(op.index + 1, -1);
+            focusIndex = qMin(op.index, model.size() - 1);
+        } else {
+            if (!model.modify(op.index, op.value)) {
+                continue;
+            }
+            timeline.start(op.index, EDIT_HIGHLIGHT_MS, false);
+            focusIndex = op.index;
+        }
+        ++applied;
     }
     
-    if (!prev || !prev->next) {
-        return false;
+    if (applied > 0) {
+        finishBatch(focusIndex);
     }
+    return applied;
+}
+
+int LinkedListWidget::insertRange(int index, const QStringList &values)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int insertIndex = index < 0 ? 0 : qMin(index + 1, model.size());
+    int inserted = model.insertRange(index, values);
     
-    ListNode *toDelete = prev->next;
-    toDelete->isHighlighted = true;
-    update();
-    
-    animateNode(index);
+    timeline.shiftIndices(insertIndex, inserted);
+    for (int k = 0; k < inserted; ++k) {
+        timeline.start(insertIndex + k, INSERT_HIGHLIGHT_MS, false);
+    }
     
-    QTimer::singleShot(500, this, [this, index, prev, toDelete]() {
-        prev->next = toDelete->next;
-        delete toDelete;
-        
-        // 更新后续节点的索引
-        ListNode *current = prev->next;
-        int count = index;
-        while (current) {
-            current->index = count++;
-            current = current->next;
-        }
-        
-        listSize--;
+    if (inserted > 0) {
+        finishBatch(insertIndex);
+    }
+    return inserted;
+}
+
+int LinkedListWidget::appendValues(const QStringList &values)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 末尾的前驱由指针缓存记住，逐块追加不需要重新遍历
+    int appended = model.insertRange(model.size() - 1, values);
+    if (appended > 0) {
         updateLayout();
         update();
-    });
-    
-    return true;
+    }
+    return appended;
 }
 
-bool LinkedListWidget::modifyElement(int index, const QString &value)
+int LinkedListWidget::deleteRange(int index, int count)
 {
-    if (index < 0 || index >= listSize) {
-        return false;
-    }
-    
-    ListNode *node = getNodeAt(index);
-    if (!node) {
-        return false;
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int removed = model.removeRange(index, count);
+    if (removed > 0) {
+        for (int k = 0; k < removed; ++k) {
+            timeline.remove(index + k);
+        }
+        timeline.shiftIndices(index + removed, -removed);
+        finishBatch(qMin(index, model.size() - 1));
     }
-    
-    node->isHighlighted = true;
+    return removed;
+}
+
+void LinkedListWidget::finishBatch(int focusIndex)
+{
+    // 整批操作只布局一次，受影响的节点一起高亮，只有最后一个弹起
+    updateLayout();
     update();
     
-    animateNode(index);
+    if (focusIndex >= 0) {
+        startEffect(focusIndex, 0, true);
+    } else if (!timeline.isEmpty() && !frameTimer->isActive()) {
+        frameTimer->start();
+    }
+}
+
+void LinkedListWidget::startEffect(int index, int highlightMs, bool bounce)
+{
+    if (bounce) {
+        ensureIndexVisible(index);
+    }
+    timeline.start(index, highlightMs, bounce);
+    markNodeDirty(index);
     
-    QTimer::singleShot(500, this, [this, index, value]() {
-        ListNode *node = getNodeAt(index);
-        if (node) {
-            node->value = value;
-            node->isHighlighted = false;
-        }
+    // 动画关闭时时间线保持为空，不需要启动帧定时器
+    if (!timeline.isEmpty() && !frameTimer->isActive()) {
+        frameTimer->start();
+    }
+}
+
+void LinkedListWidget::setAnimationsEnabled(bool enabled)
+{
+    timeline.setEnabled(enabled);
+    if (!enabled) {
+        frameTimer->stop();
+        invalidateBackground();
         update();
-    });
+    }
+}
+
+void LinkedListWidget::onAnimationFrame()
+{
+    hud.markAnimationFrame();
     
-    return true;
+    // 弹起或高亮刚结束的节点重绘为静止状态，仍在弹起的节点只重绘其所在区域
+    QVector<int> settled = timeline.advance();
+    for (int index : settled) {
+        markNodeDirty(index);
+    }
+    QVector<int> bouncing = raisedIndices();
+    for (int index : bouncing) {
+        update(nodeDirtyRect(index));
+    }
+    if (hud.isEnabled()) {
+        update(hud.overlayRect(rect()));
+    }
+    
+    if (timeline.isEmpty()) {
+        frameTimer->stop();
+    }
 }
 
-void LinkedListWidget::setAnimationProgress(qreal progress)
+void LinkedListWidget::resetCostCounters()
 {
-    m_animationProgress = progress;
-    if (animatingIndex >= 0) {
-        update();
+    lastOperationCost = OpCost();
+    totalOperationCost = OpCost();
+}
+
+void LinkedListWidget::freezeAnimationClock(qint64 offsetMs)
+{
+    timeline.freezeClock(offsetMs);
+}
+
+void LinkedListWidget::setOverviewMode(bool enabled)
+{
+    if (overviewMode == enabled) {
+        return;
     }
+    
+    // 节点数量和尺寸都没变，需要清除上次的求解结果
+    overviewMode = enabled;
+    layoutKeyCount = -1;
+    updateLayout();
+    update();
 }
 
-void LinkedListWidget::animateNode(int index)
+void LinkedListWidget::setHudVisible(bool visible)
 {
-    animatingIndex = index;
-    animation->stop();
-    animation->setStartValue(0.0);
-    animation->setEndValue(1.0);
-    animation->start();
+    hud.setEnabled(visible);
+    update();
 }
 
 void LinkedListWidget::updateLayout()
 {
-    if (!head || listSize <= 0) {
+    PerfHud::Scope layoutScope(hud, PerfHud::LayoutMetric);
+    invalidateBackground();
+    
+    int listSize = model.size();
+    if (!model.head() || listSize <= 0) {
+        contentHeight = 0;
+        layoutKeyCount = -1;
+        updateScrollBar();
         return;
     }
     
@@ -320,164 +321,365 @@ void LinkedListWidget::updateLayout()
         return;
     }
     
+    // 节点数量和组件尺寸都没变时沿用上次的求解结果
+    if (listSize == layoutKeyCount && width() == layoutKeyWidth && height() == layoutKeyHeight) {
+        layoutReady = true;
+        return;
+    }
+    
     // 计算可用空间（不包括头节点）
     int availableWidth = width() - 2 * HORIZONTAL_MARGIN;
     int availableHeight = height() - 2 * VERTICAL_MARGIN;
     
-    // 计算每行能放多少个节点（包括箭头）
-    int bestNodesPerRow = 1;
-    int bestNodeWidth = MIN_NODE_WIDTH;
-    int bestNodeHeight = MIN_NODE_HEIGHT;
-    int bestArrowLength = MIN_ARROW_LENGTH;
-    int bestSpacing = MIN_SPACING;
-    
-    // 尝试找到最佳的布局配置
-    for (int testWidth = MAX_NODE_WIDTH; testWidth >= MIN_NODE_WIDTH; testWidth -= 5) {
-        for (int testArrow = MIN_ARROW_LENGTH; testArrow <= MAX_ARROW_LENGTH; testArrow += 5) {
-            for (int testSpacing = MIN_SPACING; testSpacing <= 20; testSpacing += 2) {
-                int nodeUnitWidth = testWidth + testArrow + testSpacing;
-                int cols = (availableWidth + testSpacing) / nodeUnitWidth;
-                if (cols < 1) cols = 1;
-                
-                int rows = (listSize + cols - 1) / cols;
-                int testHeight = (availableHeight - (rows - 1) * 30) / rows;  // 行间距30（包括索引空间）
-                
-                if (testHeight >= MIN_NODE_HEIGHT && testHeight <= MAX_NODE_HEIGHT) {
-                    if (cols * rows >= listSize) {
-                        bestNodesPerRow = cols;
-                        bestNodeWidth = testWidth;
-                        bestNodeHeight = testHeight;
-                        bestArrowLength = testArrow;
-                        bestSpacing = testSpacing;
-                        break;
-                    }
-                }
-            }
-            if (bestNodesPerRow > 1) break;
+    // 直接求解：由可用高度得到最多能放的行数，由行数得到每行至少需要的列数，
+    // 再由列数得到能放下的最大节点宽度（每个节点单元包括节点、箭头和间距）
+    int maxRows = qMax(1, (availableHeight + ROW_SPACING) / (MIN_NODE_HEIGHT + ROW_SPACING));
+    int neededCols = (listSize + maxRows - 1) / maxRows;
+    int fitWidth = (availableWidth + MIN_SPACING) / neededCols - MIN_SPACING - MIN_ARROW_LENGTH;
+    
+    arrowLength = MIN_ARROW_LENGTH;
+    spacing = MIN_SPACING;
+    rowSpacing = ROW_SPACING;
+    detail = LinearPainter::FullDetail;
+    int headSpacing = HEAD_SPACING;
+    if (fitWidth < MIN_NODE_WIDTH && overviewMode) {
+        // 概览：不设最小尺寸，整个链表缩小到可视区域内
+        headSpacing = solveOverviewLayout(listSize, availableWidth, availableHeight);
+    } else if (fitWidth < MIN_NODE_WIDTH) {
+        // 最小尺寸也放不下：使用最小尺寸并启用滚动（为滚动条让出宽度）
+        availableWidth -= vScrollBar->sizeHint().width();
+        nodeWidth = MIN_NODE_WIDTH;
+        nodeHeight = MIN_NODE_HEIGHT;
+        nodesPerRow = qMax(1, (availableWidth + spacing) / (nodeWidth + arrowLength + spacing));
+        totalRows = (listSize + nodesPerRow - 1) / nodesPerRow;
+    } else {
+        nodeWidth = boundedInt(MIN_NODE_WIDTH, fitWidth, MAX_NODE_WIDTH);
+        nodesPerRow = qMax(1, (availableWidth + spacing) / (nodeWidth + arrowLength + spacing));
+        totalRows = (listSize + nodesPerRow - 1) / nodesPerRow;
+        nodeHeight = boundedInt(MIN_NODE_HEIGHT, (availableHeight - (totalRows - 1) * ROW_SPACING) / totalRows,
+                                MAX_NODE_HEIGHT);
+        
+        // 剩余宽度平均分给每个节点后面的箭头
+        int usedWidth = nodesPerRow * (nodeWidth + arrowLength + spacing) - spacing;
+        arrowLength = boundedInt(MIN_ARROW_LENGTH, arrowLength + (availableWidth - usedWidth) / nodesPerRow,
+                                 MAX_ARROW_LENGTH);
+    }
+    
+    // 计算实际节点区域的总宽度和总高度
+    int nodeUnitWidth = nodeWidth + arrowLength + spacing;
+    int totalNodeWidth = nodesPerRow * nodeUnitWidth - spacing;  // 最后一行不需要间距
+    int totalNodeHeight = totalRows * nodeHeight + (totalRows - 1) * rowSpacing;
+    
+    // 头节点单独占一行，节点位置不再逐个保存，由 nodePosition() 按网格参数计算
+    startX = HORIZONTAL_MARGIN + (availableWidth - totalNodeWidth) / 2;
+    startY = VERTICAL_MARGIN + nodeHeight + headSpacing;
+    contentHeight = startY + totalNodeHeight + VERTICAL_MARGIN;
+    
+    layoutKeyCount = listSize;
+    layoutKeyWidth = width();
+    layoutKeyHeight = height();
+    layoutReady = true;
+    updateTextLayout();
+    updateScrollBar();
+}
+
+int LinkedListWidget::solveOverviewLayout(int count, int availableWidth, int availableHeight)
+{
+    // 节点取正方形：先由每个节点（连同头节点）平均分到的面积估计间距，再逐步缩小到全部放得下；
+    // 完整细节还要画箭头和索引，按最小箭头长度和行间距留出空间，简化和色带层级的节点之间只留间隙
+    int pitch = qMax(1, int(std::sqrt(qreal(availableWidth) * availableHeight / (count + 1))));
+    int headSpacing = HEAD_SPACING;
+    for (;; --pitch) {
+        int gap = LinearPainter::overviewGap(pitch);
+        int cell = pitch - gap;
+        detail = LinearPainter::detailFor(cell, cell);
+        if (detail == LinearPainter::FullDetail) {
+            arrowLength = MIN_ARROW_LENGTH;
+            spacing = MIN_SPACING;
+            rowSpacing = ROW_SPACING;
+            headSpacing = HEAD_SPACING;
+        } else {
+            arrowLength = gap;
+            spacing = 0;
+            rowSpacing = gap;
+            headSpacing = gap;
         }
-        if (bestNodesPerRow > 1) break;
+        nodesPerRow = qMax(1, (availableWidth + spacing) / (cell + arrowLength + spacing));
+        totalRows = (count + nodesPerRow - 1) / nodesPerRow;
+        int neededHeight = cell + headSpacing + totalRows * (cell + rowSpacing) - rowSpacing;
+        if (neededHeight <= availableHeight || pitch == 1) {
+            nodeWidth = cell;
+            nodeHeight = cell;
+            break;
+        }
+    }
+    
+    if (1 + totalRows > availableHeight) {
+        // 每个节点一个像素也放不下：保持一个像素并启用滚动（为滚动条让出宽度）
+        nodesPerRow = qMax(1, availableWidth - vScrollBar->sizeHint().width());
+        totalRows = (count + nodesPerRow - 1) / nodesPerRow;
+    }
+    return headSpacing;
+}
+
+void LinkedListWidget::ensureLayout()
+{
+    if (!layoutReady) {
+        updateLayout();
+    }
+}
+
+void LinkedListWidget::updateTextLayout()
+{
+    // 字体只随节点大小变化，整个组件共用；尺寸不变时缓存保持有效
+    valueTexts.setFont(QFont("Arial", qMax(8, qMin(12, nodeWidth / 8)), QFont::Bold));
+    valueTexts.setMaxWidth(nodeWidth - 2 * TEXT_PADDING);
+    indexTexts.setFont(QFont("Arial", 8));
+    indexTexts.setMaxWidth(nodeWidth);
+}
+
+void LinkedListWidget::updateScrollBar()
+{
+    int overflow = contentHeight - height();
+    if (overflow > 0) {
+        int barWidth = vScrollBar->sizeHint().width();
+        vScrollBar->setGeometry(width() - barWidth, 0, barWidth, height());
+        vScrollBar->setRange(0, overflow);
+        vScrollBar->setPageStep(height());
+        vScrollBar->setSingleStep(nodeHeight + rowSpacing);
+        vScrollBar->show();
+    } else {
+        vScrollBar->setRange(0, 0);
+        vScrollBar->hide();
     }
+}
+
+QPointF LinkedListWidget::headPosition() const
+{
+    return QPointF(HORIZONTAL_MARGIN, VERTICAL_MARGIN - vScrollBar->value());
+}
+
+QPointF LinkedListWidget::nodePosition(int index) const
+{
+    int row = index / nodesPerRow;
+    int col = index % nodesPerRow;
     
-    // 如果没找到合适的，使用最小尺寸
-    if (bestNodesPerRow == 1) {
-        bestNodeWidth = qMin(MAX_NODE_WIDTH, (availableWidth - MIN_ARROW_LENGTH - MIN_SPACING) / 2);
-        bestNodeHeight = qMin(MAX_NODE_HEIGHT, availableHeight);
-        bestArrowLength = MIN_ARROW_LENGTH;
-        bestSpacing = MIN_SPACING;
-        int nodeUnitWidth = bestNodeWidth + bestArrowLength + bestSpacing;
-        bestNodesPerRow = (availableWidth + bestSpacing) / nodeUnitWidth;
-        if (bestNodesPerRow < 1) bestNodesPerRow = 1;
+    int x = startX + col * (nodeWidth + arrowLength + spacing);
+    int y = startY + row * (nodeHeight + rowSpacing) - vScrollBar->value();
+    return QPointF(x, y);
+}
+
+int LinkedListWidget::nodeIndexAt(const QPointF &pos) const
+{
+    if (model.size() <= 0) {
+        return -1;
     }
     
-    // 更新成员变量
-    nodeWidth = bestNodeWidth;
-    nodeHeight = bestNodeHeight;
-    arrowLength = bestArrowLength;
-    spacing = bestSpacing;
-    nodesPerRow = bestNodesPerRow;
-    totalRows = (listSize + nodesPerRow - 1) / nodesPerRow;
+    // 节点网格是均匀的：先换算成内容坐标，再直接求出行列（箭头和间距不算节点）
+    int columnPitch = nodeWidth + arrowLength + spacing;
+    int rowPitch = nodeHeight + rowSpacing;
+    qreal x = pos.x() - startX;
+    qreal y = pos.y() + vScrollBar->value() - startY;
+    if (x < 0 || y < 0) {
+        return -1;
+    }
     
-    // 计算头节点位置（单独一行或第一行）
-    int headX = HORIZONTAL_MARGIN;
-    int headY = VERTICAL_MARGIN;
+    int col = int(x) / columnPitch;
+    int row = int(y) / rowPitch;
+    if (col >= nodesPerRow) {
+        return -1;
+    }
+    if (x - col * columnPitch > nodeWidth || y - row * rowPitch > nodeHeight) {
+        return -1;
+    }
     
-    // 计算实际节点区域的总宽度和总高度
-    int nodeUnitWidth = nodeWidth + arrowLength + spacing;
-    int totalNodeWidth = nodesPerRow * nodeUnitWidth - spacing;  // 最后一行不需要间距
-    int totalNodeHeight = totalRows * nodeHeight + (totalRows - 1) * 30;  // 行间距30（包括索引空间）
+    int index = row * nodesPerRow + col;
+    return index < model.size() ? index : -1;
+}
+
+void LinkedListWidget::visibleRange(int &first, int &last) const
+{
+    // 每行在内容坐标中占据 [行顶 - 索引标签高度, 行底 + 行间箭头]
+    int rowPitch = nodeHeight + rowSpacing;
+    int viewTop = vScrollBar->value();
+    int viewBottom = viewTop + height();
     
-    int startX = HORIZONTAL_MARGIN + (availableWidth - totalNodeWidth) / 2;
-    int startY = headY + nodeHeight + 20;  // 头节点下方留20像素间距
+    int firstRow = qMax(0, (viewTop - startY - rowPitch) / rowPitch);
+    int lastRow = qMax(0, (viewBottom - startY + INDEX_LABEL_HEIGHT) / rowPitch);
     
-    // 设置头节点位置
-    head->targetPosition = QPointF(headX, headY);
-    head->position = QPointF(headX, headY);
+    first = qMin(model.size(), firstRow * nodesPerRow);
+    last = qMin(model.size(), (lastRow + 1) * nodesPerRow);
+}
+
+void LinkedListWidget::ensureIndexVisible(int index)
+{
+    ensureLayout();
+    if (vScrollBar->maximum() <= 0 || index < 0 || index >= model.size()) {
+        return;
+    }
     
-    // 计算每个实际节点的位置（支持换行）
-    ListNode *current = head->next;
-    int index = 0;
+    int rowTop = startY + (index / nodesPerRow) * (nodeHeight + rowSpacing) - INDEX_LABEL_HEIGHT;
+    int rowBottom = rowTop + INDEX_LABEL_HEIGHT + nodeHeight;
+    int viewTop = vScrollBar->value();
     
-    while (current) {
-        int row = index / nodesPerRow;
-        int col = index % nodesPerRow;
-        
-        int x = startX + col * nodeUnitWidth;
-        int y = startY + row * (nodeHeight + 30);  // 行间距30（包括索引空间）
-        
-        QPointF basePos(x, y);
-        current->targetPosition = basePos;
-        current->position = basePos;
-        
-        current = current->next;
-        index++;
+    if (rowTop < viewTop) {
+        vScrollBar->setValue(rowTop - VERTICAL_MARGIN);
+    } else if (rowBottom > viewTop + height()) {
+        vScrollBar->setValue(rowBottom - height() + VERTICAL_MARGIN);
     }
 }
 
 void LinkedListWidget::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
-    updateLayout();
-    update();  // 确保窗口大小变化时立即刷新
+    // 拖动窗口时会连续收到多次 resizeEvent，这里只标记布局失效，
+    // 由下一次 paintEvent 统一计算，每帧最多求解一次
+    layoutReady = false;
+    update();
+}
+
+void LinkedListWidget::wheelEvent(QWheelEvent *event)
+{
+    // 滚轮事件交给滚动条处理
+    if (vScrollBar->maximum() > 0) {
+        QCoreApplication::sendEvent(vScrollBar, event);
+        return;
+    }
+    QWidget::wheelEvent(event);
 }
 
 void LinkedListWidget::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
-    
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    if (hud.isEnabled()) {
+        qint64 dirtyPixels = 0;
+        for (const QRect &r : event->region()) {
+            dirtyPixels += qint64(r.width()) * r.height();
+        }
+        hud.setRepaintArea(dirtyPixels, qint64(width()) * height());
+    }
     
-    // 绘制背景
-    painter.fillRect(rect(), QColor(240, 240, 240));
+    {
+        PerfHud::Scope paintScope(hud, PerfHud::PaintMetric);
+        paintContent(painter);
+    }
     
-    if (!head) {
+    // 性能面板不计入绘制耗时
+    if (hud.isEnabled()) {
+        hud.paint(painter, rect());
+    }
+}
+
+void LinkedListWidget::paintContent(QPainter &painter)
+{
+    if (!model.head()) {
+        painter.fillRect(rect(), QColor(240, 240, 240));
         return;
     }
     
-    // 先绘制所有箭头（在节点下方，避免被节点遮挡）
-    ListNode *current = head;
-    int index = -1;
+    // 确保布局已更新
+    ensureLayout();
+    
+    // 静态内容（背景、箭头、非弹起节点）缓存在图层中，
+    // 动画过程中每帧只需贴图一次并重绘正在弹起的节点
+    QVector<int> bouncing = raisedIndices();
+    std::sort(bouncing.begin(), bouncing.end());
+    qreal ratio = devicePixelRatioF();
+    QSize cacheSize = size() * ratio;
+    if (!backgroundValid || backgroundCache.size() != cacheSize) {
+        backgroundCache = QPixmap(cacheSize);
+        backgroundCache.setDevicePixelRatio(ratio);
+        QPainter cachePainter(&backgroundCache);
+        renderBackground(cachePainter);
+        backgroundSkipped = bouncing;
+        backgroundValid = true;
+        backgroundDirty = QRegion();
+    } else {
+        // 开始或结束弹起的节点所在区域需要重新生成（屏幕上的重绘已由动画帧安排）
+        if (backgroundSkipped != bouncing) {
+            for (int index : backgroundSkipped) {
+                backgroundDirty += nodeDirtyRect(index);
+            }
+            for (int index : bouncing) {
+                backgroundDirty += nodeDirtyRect(index);
+            }
+            backgroundSkipped = bouncing;
+        }
+        // 只重绘图层中的脏区域
+        if (!backgroundDirty.isEmpty()) {
+            QPainter cachePainter(&backgroundCache);
+            cachePainter.setClipRegion(backgroundDirty);
+            renderBackground(cachePainter);
+            backgroundDirty = QRegion();
+        }
+    }
+    painter.drawPixmap(0, 0, backgroundCache);
     
-    // 绘制头节点到第一个节点的箭头
-    if (head && head->next && listSize > 0) {
-        QPointF headPos = head->targetPosition;
-        ListNode *firstNode = head->next;
-        QPointF firstPos = firstNode->targetPosition;
-        
-        // 计算箭头起点和终点
-        QPointF arrowStart(headPos.x() + nodeWidth, headPos.y() + nodeHeight / 2);
-        QPointF arrowEnd(firstPos.x() - arrowLength, firstPos.y() + nodeHeight / 2);
-        
-        // 如果第一个节点在下一行，绘制向下的箭头
-        if (firstPos.y() > headPos.y() + nodeHeight) {
-            arrowStart = QPointF(headPos.x() + nodeWidth / 2, headPos.y() + nodeHeight);
-            arrowEnd = QPointF(firstPos.x() + nodeWidth / 2, firstPos.y());
+    if (!bouncing.isEmpty()) {
+        painter.setRenderHint(QPainter::Antialiasing);
+    }
+    for (int index : bouncing) {
+        ListNode *node = model.nodeAt(index);
+        if (!node) {
+            continue;
         }
         
-        painter.setPen(QPen(QColor(100, 100, 100), 2));
-        painter.drawLine(arrowStart, arrowEnd);
+        // 计算动画位置
+        QPointF pos = nodePosition(index);
+        pos.setY(pos.y() - BOUNCE_HEIGHT * timeline.bounceHeight(index));
+        paintNode(painter, node, index, pos);
+    }
+}
+
+void LinkedListWidget::renderBackground(QPainter &painter)
+{
+    ListNode *head = model.head();
+    
+    // 只绘制与可视区域相交的节点
+    int listSize = model.size();
+    int first = 0;
+    int last = 0;
+    visibleRange(first, last);
+    if (hud.isEnabled()) {
+        hud.setElementCounts(last - first, listSize - (last - first));
+        hud.setValuePoolStats(ValuePool::shared().stats());
+    }
+    
+    QPointF headPos = headPosition();
+    bool headVisible = headPos.y() + nodeHeight >= 0;
+    
+    // 简化和色带层级不显示值，只需要索引，不沿指针遍历；色带图像本身包括背景
+    if (detail == LinearPainter::StripDetail) {
+        renderStrip(painter, first, last);
+        return;
+    }
+    
+    // 绘制背景
+    painter.fillRect(rect(), QColor(240, 240, 240));
+    if (detail == LinearPainter::ReducedDetail) {
+        renderReduced(painter, first, last, headVisible);
+        return;
+    }
+    painter.setRenderHint(QPainter::Antialiasing);
+    ListNode *firstVisible = model.nodeAt(first);
+    
+    // 先绘制所有箭头（在节点下方，避免被节点遮挡）
+    // 双向链接画成一对反向箭头：next 在上方（竖直时在左侧），prev 在下方（竖直时在右侧）
+    // 绘制头节点到第一个节点的箭头
+    if (headVisible && head->next && listSize > 0) {
+        QPointF firstPos = nodePosition(0);
         
-        // 绘制箭头头部
-        QPointF arrowHead = arrowEnd;
-        QPolygonF arrowHeadPoly;
-        if (firstPos.y() > headPos.y() + nodeHeight) {
-            // 向下箭头
-            arrowHeadPoly << arrowHead << QPointF(arrowHead.x() - 4, arrowHead.y() - 8)
-                         << QPointF(arrowHead.x() + 4, arrowHead.y() - 8);
-        } else {
-            // 水平箭头
-            arrowHeadPoly << arrowHead << QPointF(arrowHead.x() - 8, arrowHead.y() - 4)
-                         << QPointF(arrowHead.x() - 8, arrowHead.y() + 4);
-        }
-        painter.setBrush(QColor(100, 100, 100));
-        painter.drawPolygon(arrowHeadPoly);
+        // 第一个节点总在头节点下方，绘制向下的箭头
+        QPointF arrowStart(headPos.x() + nodeWidth / 2, headPos.y() + nodeHeight);
+        QPointF arrowEnd(firstPos.x() + nodeWidth / 2, firstPos.y());
+        drawLinkPair(painter, arrowStart, arrowEnd);
     }
     
     // 绘制实际节点之间的箭头
-    current = head->next;
-    index = 0;
-    while (current && current->next) {
-        QPointF pos = current->targetPosition;
+    ListNode *current = firstVisible;
+    int index = first;
+    while (current && current->next && index < last) {
+        QPointF pos = nodePosition(index);
         int currentRow = index / nodesPerRow;
         int nextIndex = index + 1;
         int nextRow = nextIndex / nodesPerRow;
@@ -486,129 +688,181 @@ void LinkedListWidget::paintEvent(QPaintEvent *event)
         if (currentRow == nextRow && nextIndex < listSize) {
             QPointF arrowStart(pos.x() + nodeWidth, pos.y() + nodeHeight / 2);
             QPointF arrowEnd(arrowStart.x() + arrowLength, arrowStart.y());
-        
-            painter.setPen(QPen(QColor(100, 100, 100), 2));
-            painter.drawLine(arrowStart, arrowEnd);
-            
-            // 绘制箭头头部
-            QPointF arrowHead = arrowEnd;
-            QPolygonF arrowHeadPoly;
-            arrowHeadPoly << arrowHead << QPointF(arrowHead.x() - 8, arrowHead.y() - 4)
-                         << QPointF(arrowHead.x() - 8, arrowHead.y() + 4);
-            painter.setBrush(QColor(100, 100, 100));
-            painter.drawPolygon(arrowHeadPoly);
+            drawLinkPair(painter, arrowStart, arrowEnd);
         }
         // 如果下一行，绘制向下的箭头
         else if (nextRow > currentRow && nextIndex < listSize) {
             QPointF arrowStart(pos.x() + nodeWidth / 2, pos.y() + nodeHeight);
-            QPointF arrowEnd(arrowStart.x(), arrowStart.y() + 30);  // 行间距30
-            
-            painter.setPen(QPen(QColor(100, 100, 100), 2));
-            painter.drawLine(arrowStart, arrowEnd);
-            
-            // 绘制向下的箭头头部
-            QPointF arrowHead = arrowEnd;
-            QPolygonF arrowHeadPoly;
-            arrowHeadPoly << arrowHead << QPointF(arrowHead.x() - 4, arrowHead.y() - 8)
-                         << QPointF(arrowHead.x() + 4, arrowHead.y() - 8);
-            painter.setBrush(QColor(100, 100, 100));
-            painter.drawPolygon(arrowHeadPoly);
+            QPointF arrowEnd(arrowStart.x(), arrowStart.y() + rowSpacing);
+            drawLinkPair(painter, arrowStart, arrowEnd);
         }
         
         current = current->next;
         index++;
     }
     
-    // 再绘制所有节点（在箭头上方）
-    current = head;
-    index = -1;
+    // 再绘制所有节点（在箭头上方），头节点仅在可见时绘制
+    if (headVisible) {
+        paintNode(painter, head, -1, headPos);
+    }
     
-    while (current) {
-        QPointF pos = current->targetPosition;
-        
-        // 计算动画位置
-        QPointF currentPos = pos;
-        if (index == animatingIndex && animation->state() == QAbstractAnimation::Running) {
-            qreal scale = 1.0 + 0.2 * sin(m_animationProgress * 3.14159);
-            currentPos.setY(pos.y() - 10 * (1.0 - qAbs(m_animationProgress - 0.5) * 2));
-        }
-        
-        // 绘制节点框（使用动态计算的尺寸）
-        QRectF nodeRect(currentPos.x(), currentPos.y(), nodeWidth, nodeHeight);
-        
-        // 选择颜色
-        QColor bgColor;
-        QColor borderColor;
-        
-        if (index == -1) {
-            // 头节点
-            bgColor = QColor(255, 220, 200);
-            borderColor = QColor(255, 150, 100);
-        } else if (current->isHighlighted) {
-            bgColor = QColor(100, 200, 255);
-            borderColor = QColor(50, 150, 255);
-        } else {
-            bgColor = QColor(200, 230, 255);
-            borderColor = QColor(100, 180, 255);
-        }
-        
-        // 绘制节点
-        QPen pen(borderColor, 2);
-        painter.setPen(pen);
-        painter.setBrush(bgColor);
-        painter.drawRoundedRect(nodeRect, 5, 5);
-        
-        // 绘制值（根据节点大小调整字体）
-        painter.setPen(QColor(0, 0, 0));
-        // 根据节点大小动态调整字体
-        int fontSize = qMax(8, qMin(12, nodeWidth / 8));
-        QFont valueFont("Arial", fontSize, QFont::Bold);
-        painter.setFont(valueFont);
-        painter.drawText(nodeRect, Qt::AlignCenter, current->value);
-        
-        // 绘制索引（如果不是头节点，放在节点上方以避免被下一行遮挡）
-        if (index >= 0) {
-            QFont indexFont("Arial", 8);
-            painter.setFont(indexFont);
-            painter.setPen(QColor(100, 100, 100));
-            // 将索引放在节点上方
-            QRectF indexRect(currentPos.x(), currentPos.y() - 18, nodeWidth, 15);
-            painter.drawText(indexRect, Qt::AlignCenter, QString("[%1]").arg(index));
+    current = firstVisible;
+    index = first;
+    while (current && index < last) {
+        if (!timeline.isBouncing(index)) {
+            paintNode(painter, current, index, nodePosition(index));
         }
-        
         current = current->next;
         index++;
     }
 }
 
+void LinkedListWidget::drawLinkPair(QPainter &painter, const QPointF &from, const QPointF &to)
+{
+    // 沿连线的法向两侧各偏移 LINK_OFFSET，水平连线时 next 在上，竖直连线时 next 在左
+    QPointF offset = from.y() == to.y() ? QPointF(0, LINK_OFFSET) : QPointF(LINK_OFFSET, 0);
+    LinearPainter::drawArrow(painter, from - offset, to - offset);
+    LinearPainter::drawArrow(painter, to + offset, from + offset);
+}
+
+void LinkedListWidget::renderReduced(QPainter &painter, int first, int last, bool headVisible)
+{
+    // 节点只有几个像素宽，文字和索引放不下；箭头缩成同一行相邻节点之间的一条细线，换行处不画
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    QSize cellSize(nodeWidth, nodeHeight);
+    if (headVisible) {
+        LinearPainter::drawPlainCell(painter, QRect(headPosition().toPoint(), cellSize), LinearPainter::HeadCell);
+    }
+    
+    QColor linkColor(100, 100, 100);
+    int listSize = model.size();
+    for (int index = first; index < last; ++index) {
+        QPoint pos = nodePosition(index).toPoint();
+        if (arrowLength > 0 && index + 1 < listSize && (index + 1) % nodesPerRow != 0) {
+            painter.fillRect(pos.x() + nodeWidth, pos.y() + nodeHeight / 2, arrowLength, 1, linkColor);
+        }
+        LinearPainter::drawPlainCell(painter, QRect(pos, cellSize), nodeStyle(index));
+    }
+}
+
+void LinkedListWidget::renderStrip(QPainter &painter, int first, int last)
+{
+    if (stripImage.size() != size()) {
+        stripImage = QImage(size(), QImage::Format_RGB32);
+    }
+    stripImage.fill(QColor(240, 240, 240));
+    
+    // 每种样式的颜色只换算一次；头节点单独一行，节点的可视范围总是从行首开始，逐行写入扫描线
+    QRgb palette[LinearPainter::HeadCell + 1];
+    for (int style = 0; style <= LinearPainter::HeadCell; ++style) {
+        palette[style] = LinearPainter::stripColor(LinearPainter::CellStyle(style));
+    }
+    int columnPitch = nodeWidth + arrowLength + spacing;
+    QPointF headPos = headPosition();
+    LinearPainter::fillStripRow(stripImage, int(headPos.x()), int(headPos.y()), &palette[LinearPainter::HeadCell], 1,
+                                nodeWidth, nodeHeight, columnPitch);
+    
+    QVector<QRgb> colors(nodesPerRow);
+    for (int rowStart = first; rowStart < last; rowStart += nodesPerRow) {
+        int count = qMin(nodesPerRow, last - rowStart);
+        for (int i = 0; i < count; ++i) {
+            colors[i] = palette[nodeStyle(rowStart + i)];
+        }
+        QPointF pos = nodePosition(rowStart);
+        LinearPainter::fillStripRow(stripImage, int(pos.x()), int(pos.y()), colors.constData(), count,
+                                    nodeWidth, nodeHeight, columnPitch);
+    }
+    painter.drawImage(0, 0, stripImage);
+}
+
+LinearPainter::CellStyle LinkedListWidget::nodeStyle(int index) const
+{
+    if (index == -1) {
+        return LinearPainter::HeadCell;
+    }
+    return timeline.isHighlighted(index) ? LinearPainter::HighlightedCell : LinearPainter::NormalCell;
+}
+
+QVector<int> LinkedListWidget::raisedIndices() const
+{
+    // 简化和色带层级的节点太小，弹起会盖住相邻行，只以高亮颜色画在图层中
+    if (detail != LinearPainter::FullDetail) {
+        return QVector<int>();
+    }
+    return timeline.bouncingIndices();
+}
+
+void LinkedListWidget::paintNode(QPainter &painter, const ListNode *node, int index, const QPointF &pos)
+{
+    // 绘制节点框（使用动态计算的尺寸）
+    QRectF nodeRect(pos.x(), pos.y(), nodeWidth, nodeHeight);
+    LinearPainter::drawCell(painter, nodeRect, nodeStyle(index));
+    
+    // 绘制值（字体和排版结果由缓存提供，过长的值以省略号结尾）
+    painter.setPen(QColor(0, 0, 0));
+    valueTexts.draw(painter, nodeRect, model.valueOf(node));
+    
+    // 绘制索引（如果不是头节点，放在节点上方以避免被下一行遮挡）
+    if (index >= 0) {
+        painter.setPen(QColor(100, 100, 100));
+        // 将索引放在节点上方
+        QRectF indexRect(pos.x(), pos.y() - INDEX_LABEL_HEIGHT, nodeWidth, 15);
+        indexTexts.draw(painter, indexRect, QString("[%1]").arg(index));
+    }
+}
+
+void LinkedListWidget::invalidateBackground()
+{
+    backgroundValid = false;
+}
+
+QRect LinkedListWidget::nodeDirtyRect(int index) const
+{
+    // 覆盖节点本身、上方的索引标签和弹起动画的偏移，
+    // 左右各扩展一个箭头长度、下方扩展一个行间距以包含相邻箭头
+    QPointF pos = nodePosition(index);
+    QRectF area(pos.x(), pos.y() - INDEX_LABEL_HEIGHT - BOUNCE_HEIGHT,
+                nodeWidth, nodeHeight + INDEX_LABEL_HEIGHT + BOUNCE_HEIGHT);
+    return area.adjusted(-arrowLength - 2, -2, arrowLength + 2, rowSpacing + 2).toAlignedRect();
+}
+
+void LinkedListWidget::markNodeDirty(int index)
+{
+    // 不可见的节点不在图层中，滚动到它时会整体重绘
+    int first = 0;
+    int last = 0;
+    visibleRange(first, last);
+    if (index < first || index >= last) {
+        return;
+    }
+    QRect dirty = nodeDirtyRect(index);
+    backgroundDirty += dirty;
+    update(dirty);
+}
+
+void LinkedListWidget::onScrollValueChanged()
+{
+    invalidateBackground();
+    update();
+}
+
 void LinkedListWidget::mousePressEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::LeftButton) {
+        ensureLayout();
         QPointF clickPos = event->pos();
         
-        // 检查点击了哪个节点（跳过头节点，使用动态尺寸）
-        ListNode *current = head;
-        int index = -1;
+        // 点击头节点不发出信号
+        QPointF headPos = headPosition();
+        if (QRectF(headPos.x(), headPos.y(), nodeWidth, nodeHeight).contains(clickPos)) {
+            return;
+        }
         
-        while (current) {
-            int w = (index == -1) ? nodeWidth : nodeWidth;  // 头节点和普通节点使用相同宽度
-            int h = (index == -1) ? nodeHeight : nodeHeight;
-            QRectF nodeRect(current->targetPosition.x(), 
-                          current->targetPosition.y(), 
-                          w, h);
-            
-            if (nodeRect.contains(clickPos)) {
-                // 如果不是头节点，发出信号
-                if (index >= 0) {
-                    emit elementClicked(index);
-                }
-                return;
-            }
-            
-            current = current->next;
-            index++;
+        int index = nodeIndexAt(clickPos);
+        if (index >= 0) {
+            emit elementClicked(index);
+            return;
         }
     }
     QWidget::mousePressEvent(event);
 }
-
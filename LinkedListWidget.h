@@ -3,28 +3,26 @@
 
 #include <QWidget>
 #include <QPainter>
-#include <QPropertyAnimation>
 #include <QVector>
 #include <QString>
 #include <QStringList>
 #include <QMouseEvent>
-
-struct ListNode {
-    QString value;
-    int index;
-    bool isHighlighted;
-    bool isAnimating;
-    QPointF position;
-    QPointF targetPosition;
-    ListNode *next;
-    
-    ListNode() : index(-1), isHighlighted(false), isAnimating(false), next(nullptr) {}
-};
+#include <QWheelEvent>
+#include <QScrollBar>
+#include <QPixmap>
+#include <QImage>
+#include <QRegion>
+#include <QTimer>
+#include "LinkedListModel.h"
+#include "AnimationTimeline.h"
+#include "LinearPainter.h"
+#include "LinearOp.h"
+#include "PerfHud.h"
+#include "TextLayoutCache.h"
 
 class LinkedListWidget : public QWidget
 {
     Q_OBJECT
-    Q_PROPERTY(qreal animationProgress READ animationProgress WRITE setAnimationProgress)
 
 signals:
     void elementClicked(int index);
@@ -33,41 +31,112 @@ public:
     explicit LinkedListWidget(QWidget *parent = nullptr);
     ~LinkedListWidget();
     
+    static const int DEFAULT_MAX_ELEMENTS = LinkedListModel::DEFAULT_MAX_ELEMENTS;  // 默认节点上限
+    
     void initialize(int size);
     void initialize(const QStringList &values);
-    void addElement(int index, const QString &value);
+    bool addElement(int index, const QString &value);
     bool deleteElement(int index);
     bool modifyElement(int index, const QString &value);
-    int getSize() const { return listSize; }
-    QStringList getValues() const;
     
-    qreal animationProgress() const { return m_animationProgress; }
-    void setAnimationProgress(qreal progress);
+    // 批量操作：先全部修改模型，再统一布局一次、播放一次高亮动画，返回成功的操作数
+    int applyBatch(const LinearOpList &ops);
+    int insertRange(int index, const QStringList &values);
+    int deleteRange(int index, int count);
+    int appendValues(const QStringList &values);  // 分块加载时在末尾追加，不播放动画，返回追加个数
+    int getSize() const { return model.size(); }
+    QStringList getValues() const { return model.values(); }
+    QString getValue(int index) { return model.value(index); }  // 经由指针缓存定位，连续点击相邻节点只走几步
+    void setMaxElements(int limit) { model.setMaxElements(limit); }  // 设置节点数量上限
+    int maxElements() const { return model.maxElements(); }
+    NodePoolStats poolStats() const { return model.poolStats(); }
+    const LinkedListModel &listModel() const { return model; }
+    // 概览模式：节点多到需要滚动时不再限制最小尺寸，整个链表缩小到可视区域内，
+    // 按每个节点分到的像素依次降为简化方框和色带，箭头缩成细线后省略（见 LinearPainter::DetailLevel）
+    void setOverviewMode(bool enabled);
+    bool isOverviewMode() const { return overviewMode; }
+    LinearPainter::DetailLevel detailLevel() const { return detail; }
+    void setHudVisible(bool visible);  // 显示/隐藏性能统计面板
+    void setAnimationsEnabled(bool enabled);  // 关闭后操作立即生效，不播放高亮和弹起（如高速回放）
+    bool animationsEnabled() const { return timeline.isEnabled(); }
+    bool isHudVisible() const { return hud.isEnabled(); }
+    // 开销计数：最近一次操作（批量操作算一次）和自上次清零以来的累计，只统计经由本组件接口的操作
+    OpCost lastCost() const { return lastOperationCost; }
+    OpCost totalCost() const { return totalOperationCost; }
+    void resetCostCounters();
+    void freezeAnimationClock(qint64 offsetMs);  // 定格动画进度，见 AnimationTimeline::freezeClock（离屏渲染基准用）
+    void invalidateBackground();  // 结构、尺寸或滚动变化后调用；离屏渲染基准每帧调用以测量完整的一帧
+
+private slots:
+    void onScrollValueChanged();
+    void onAnimationFrame();  // 帧定时器回调：推进时间线并重绘受影响的节点
 
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
 
 private:
     void updateLayout();
-    void animateNode(int index);
-    void clearList();
-    ListNode* getNodeAt(int index);
+    int solveOverviewLayout(int count, int availableWidth, int availableHeight);  // 返回头节点与第一行的间距
+    void ensureLayout();  // 布局失效（如窗口缩放后）时立即求解
+    void paintContent(QPainter &painter);
+    void renderBackground(QPainter &painter);  // 绘制除正在弹起的节点以外的全部可见内容
+    void renderReduced(QPainter &painter, int first, int last, bool headVisible);  // 简化层级：不抗锯齿的方框和细线
+    void renderStrip(QPainter &painter, int first, int last);  // 色带层级：写入 stripImage 后整体贴图
+    void paintNode(QPainter &painter, const ListNode *node, int index, const QPointF &pos);  // index 为 -1 表示头节点
+    LinearPainter::CellStyle nodeStyle(int index) const;  // index 为 -1 表示头节点
+    QVector<int> raisedIndices() const;  // 需要在图层之上单独绘制的弹起节点，只有完整细节层级才有
+    void drawLinkPair(QPainter &painter, const QPointF &from, const QPointF &to);  // from 到 to 的 next 箭头及反向的 prev 箭头
+    void updateTextLayout();  // 节点尺寸变化后更新共用字体
+    QRect nodeDirtyRect(int index) const;  // 节点变化时需要重绘的区域（组件坐标），包括相邻箭头
+    void markNodeDirty(int index);  // 单个节点的高亮或值变化后调用，只重绘该区域
+    void updateScrollBar();
+    void startEffect(int index, int highlightMs, bool bounce);  // 在时间线上为节点开始高亮/弹起效果
+    void finishBatch(int focusIndex);  // 批量操作后的布局和动画
+    void ensureIndexVisible(int index);
+    QPointF headPosition() const;
+    QPointF nodePosition(int index) const;  // 根据网格参数计算节点位置（已扣除滚动偏移）
+    int nodeIndexAt(const QPointF &pos) const;  // 组件坐标处的节点索引（不含头节点），不在任何节点上时返回 -1
+    void visibleRange(int &first, int &last) const;  // 可视区域内的节点范围 [first, last)
     
-    ListNode *head;
-    int listSize;
-    qreal m_animationProgress;
-    QPropertyAnimation *animation;
-    int animatingIndex;
+    LinkedListModel model;  // 数据模型，本组件只负责绘制和动画
+    AnimationTimeline timeline;  // 高亮和弹起效果，模型修改总是立即提交
+    QTimer *frameTimer;
     
     // 动态计算的尺寸
     int nodeWidth;
     int nodeHeight;
     int arrowLength;
     int spacing;
+    int rowSpacing;  // 完整细节时为 ROW_SPACING，概览的小节点与列间隙相同
     int nodesPerRow;  // 每行节点数量
     int totalRows;  // 总行数
+    int startX;  // 节点网格左上角（内容坐标）
+    int startY;
+    int contentHeight;  // 内容总高度，超出可视区域时启用滚动
+    bool layoutReady;
+    bool overviewMode;
+    LinearPainter::DetailLevel detail;  // 由布局求解得到
+    int layoutKeyCount;  // 上次求解时的节点数量和组件尺寸，用于复用结果
+    int layoutKeyWidth;
+    int layoutKeyHeight;
+    QScrollBar *vScrollBar;
+    PerfHud hud;
+    OpCost lastOperationCost;
+    OpCost totalOperationCost;
+    
+    // 静态内容图层：结构、尺寸或滚动变化时整体重绘，单个节点变化时只重绘脏区域
+    QPixmap backgroundCache;
+    bool backgroundValid;
+    QVector<int> backgroundSkipped;  // 图层中未绘制的（正在弹起的）节点，已排序
+    QRegion backgroundDirty;  // 图层中待重绘的区域
+    QImage stripImage;  // 色带层级的绘制目标，尺寸不变时复用
+    
+    // 文本排版缓存（值、索引各用一种字体）
+    TextLayoutCache valueTexts;
+    TextLayoutCache indexTexts;
     
     static const int MIN_NODE_WIDTH = 60;
     static const int MAX_NODE_WIDTH = 120;
@@ -78,6 +147,15 @@ private:
     static const int MIN_SPACING = 10;
     static const int HORIZONTAL_MARGIN = 20;
     static const int VERTICAL_MARGIN = 20;
+    static const int ROW_SPACING = 30;  // 完整细节的行间距（包括索引空间）
+    static const int HEAD_SPACING = 20;  // 头节点与第一行之间的间距
+    static const int LINK_OFFSET = 5;  // next/prev 两条箭头各自偏离节点中线的距离
+    static const int INDEX_LABEL_HEIGHT = 18;
+    static const int BOUNCE_HEIGHT = 10;  // 动画时节点弹起的最大高度
+    static const int TEXT_PADDING = 4;  // 值文本与节点边框的最小距离
+    static const int INSERT_HIGHLIGHT_MS = 600;  // 插入后的高亮时长
+    static const int EDIT_HIGHLIGHT_MS = 500;  // 修改后的高亮时长
+    static const int FRAME_INTERVAL_MS = 16;  // 动画帧间隔
 };
 
 #endif // LINKEDLISTWIDGET_H
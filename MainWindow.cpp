@@ -2,9 +2,26 @@
 #include <QMessageBox>
 #include <QApplication>
 #include <QDesktopWidget>
+#include <QInputDialog>
+#include <QFileDialog>
+
+namespace {
+
+QString formatCost(const OpCost &cost)
+{
+    return QString("移动 %1 · 重新分配 %2 · 指针 %3 · 分配 %4")
+           .arg(cost.moves).arg(cost.reallocations).arg(cost.hops).arg(cost.allocations);
+}
+
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
+    , importThread(nullptr)
+    , importer(nullptr)
+    , importProgress(nullptr)
+    , importType(0)
+    , importedCount(0)
     , currentType(0)
 {
     setWindowTitle("线性表可视化 - 数组与链表");
@@ -40,6 +57,10 @@ void MainWindow::showEvent(QShowEvent *event)
 
 MainWindow::~MainWindow()
 {
+    if (importer) {
+        importer->cancel();
+        finishImport();
+    }
 }
 
 void MainWindow::setupUI()
@@ -57,19 +78,35 @@ void MainWindow::setupUI()
     typeComboBox = new QComboBox(this);
     typeComboBox->addItem("数组 (Array)");
     typeComboBox->addItem("链表 (LinkedList)");
+    typeComboBox->addItem("展开链表 (UnrolledList)");
     
     initButton = new QPushButton("初始化", this);
     insertButton = new QPushButton("插入元素", this);
     deleteButton = new QPushButton("删除元素", this);
     modifyButton = new QPushButton("修改元素", this);
+    batchButton = new QPushButton("批量操作", this);
+    recordButton = new QPushButton("录制", this);
+    recordButton->setCheckable(true);
+    replayButton = new QPushButton("回放", this);
+    ringCheckBox = new QCheckBox("环形缓冲", this);
+    ringCheckBox->setToolTip("数组两端的插入和删除为 O(1)，删除两端元素时位置一起移除");
+    overviewCheckBox = new QCheckBox("概览", this);
+    overviewCheckBox->setToolTip("元素过多时不滚动，整个结构缩小显示，格子很小时只画方框或色块");
+    hudCheckBox = new QCheckBox("性能面板", this);
     
     controlLayout->addWidget(new QLabel("类型:", this));
     controlLayout->addWidget(typeComboBox);
+    controlLayout->addWidget(ringCheckBox);
     controlLayout->addWidget(initButton);
     controlLayout->addWidget(insertButton);
     controlLayout->addWidget(deleteButton);
     controlLayout->addWidget(modifyButton);
+    controlLayout->addWidget(batchButton);
+    controlLayout->addWidget(recordButton);
+    controlLayout->addWidget(replayButton);
     controlLayout->addStretch();
+    controlLayout->addWidget(overviewCheckBox);
+    controlLayout->addWidget(hudCheckBox);
     
     // 输入面板
     inputGroup = new QGroupBox("输入参数", this);
@@ -83,9 +120,14 @@ void MainWindow::setupUI()
     initEdit->setMinimumWidth(300);
     initHintLabel = new QLabel("", this);
     initHintLabel->setStyleSheet("color: green;");
+    initValidateTimer = new QTimer(this);
+    initValidateTimer->setSingleShot(true);
+    initValidateTimer->setInterval(INIT_VALIDATE_DELAY_MS);
+    loadFileButton = new QPushButton("从文件加载", this);
     
     initLayout->addWidget(initLabel);
     initLayout->addWidget(initEdit);
+    initLayout->addWidget(loadFileButton);
     initLayout->addWidget(initHintLabel);
     initLayout->addStretch();
     
@@ -94,7 +136,6 @@ void MainWindow::setupUI()
     indexLabel = new QLabel("索引:", this);
     indexSpinBox = new QSpinBox(this);
     indexSpinBox->setMinimum(0);
-    indexSpinBox->setMaximum(29);
     indexSpinBox->setValue(0);
     
     valueLabel = new QLabel("值:", this);
@@ -107,6 +148,9 @@ void MainWindow::setupUI()
     inputLayout->addWidget(valueLabel);
     inputLayout->addWidget(valueEdit);
     inputLayout->addStretch();
+    costLabel = new QLabel("", this);
+    costLabel->setStyleSheet("color: gray;");
+    inputLayout->addWidget(costLabel);
     
     inputMainLayout->addLayout(initLayout);
     inputMainLayout->addLayout(inputLayout);
@@ -116,7 +160,13 @@ void MainWindow::setupUI()
 
     linkedListWidget = new LinkedListWidget(this);
     
+    unrolledListWidget = new UnrolledListWidget(this);
+    unrolledListWidget->hide();
+    
     currentWidget = arrayWidget;
+    indexSpinBox->setMaximum(arrayWidget->maxElements() - 1);
+    
+    replayer = new TraceReplayer(arrayWidget, linkedListWidget, unrolledListWidget, this);
 
     mainLayout->addWidget(controlGroup);
     mainLayout->addWidget(inputGroup);
@@ -141,9 +191,21 @@ void MainWindow::setupConnections()
     connect(insertButton, SIGNAL(clicked()), this, SLOT(onInsertClicked()));
     connect(deleteButton, SIGNAL(clicked()), this, SLOT(onDeleteClicked()));
     connect(modifyButton, SIGNAL(clicked()), this, SLOT(onModifyClicked()));
-    connect(initEdit, SIGNAL(textChanged(QString)), this, SLOT(onInitTextChanged()));
+    connect(batchButton, SIGNAL(clicked()), this, SLOT(onBatchClicked()));
+    // 每次按键只重新开始计时，粘贴大段文本时不会逐字符扫描
+    connect(initEdit, SIGNAL(textChanged(QString)), initValidateTimer, SLOT(start()));
+    connect(initValidateTimer, SIGNAL(timeout()), this, SLOT(onInitTextChanged()));
+    connect(hudCheckBox, SIGNAL(toggled(bool)), this, SLOT(onHudToggled(bool)));
+    connect(ringCheckBox, SIGNAL(toggled(bool)), this, SLOT(onRingToggled(bool)));
+    connect(overviewCheckBox, SIGNAL(toggled(bool)), this, SLOT(onOverviewToggled(bool)));
+    connect(recordButton, SIGNAL(toggled(bool)), this, SLOT(onRecordToggled(bool)));
+    connect(replayButton, SIGNAL(clicked()), this, SLOT(onReplayClicked()));
+    connect(loadFileButton, SIGNAL(clicked()), this, SLOT(onLoadFileClicked()));
+    connect(replayer, SIGNAL(structureChanged(int)), this, SLOT(onReplayStructureChanged(int)));
+    connect(replayer, SIGNAL(finished(int,int,qint64)), this, SLOT(onReplayFinished(int,int,qint64)));
     connect(arrayWidget, SIGNAL(elementClicked(int)), this, SLOT(onArrayElementClicked(int)));
     connect(linkedListWidget, SIGNAL(elementClicked(int)), this, SLOT(onLinkedListElementClicked(int)));
+    connect(unrolledListWidget, SIGNAL(elementClicked(int)), this, SLOT(onUnrolledListElementClicked(int)));
 }
 
 void MainWindow::onTypeChanged(int index)
@@ -155,13 +217,18 @@ void MainWindow::onTypeChanged(int index)
     
     if (index == 0) {
         currentWidget = arrayWidget;
-    } else {
+    } else if (index == 1) {
         currentWidget = linkedListWidget;
+    } else {
+        currentWidget = unrolledListWidget;
     }
     
     currentWidget->show();
     mainLayout->addWidget(currentWidget, 1);
+    ringCheckBox->setEnabled(index == 0);
+    overviewCheckBox->setEnabled(index != 2);
     updateIndexRange();
+    updateCostLabel();
     
     // 强制刷新界面，清除所有高亮状态
     currentWidget->update();
@@ -171,53 +238,69 @@ void MainWindow::onTypeChanged(int index)
     QApplication::processEvents();
 }
 
+void MainWindow::onRingToggled(bool checked)
+{
+    // 已有元素保持原顺序，之后录制的数组操作记为环形数组
+    arrayWidget->setRingMode(checked);
+    updateCostLabel();
+}
+
+void MainWindow::onOverviewToggled(bool checked)
+{
+    // 只改变显示方式，不影响数据和录制
+    arrayWidget->setOverviewMode(checked);
+    linkedListWidget->setOverviewMode(checked);
+}
+
+void MainWindow::onHudToggled(bool checked)
+{
+    arrayWidget->setHudVisible(checked);
+    linkedListWidget->setHudVisible(checked);
+    unrolledListWidget->setHudVisible(checked);
+}
+
 QStringList MainWindow::parseInputString(const QString &input, bool &isValid)
 {
-    QStringList result;
-    isValid = true;
-    
-    if (input.trimmed().isEmpty()) {
-        isValid = false;
-        return result;
-    }
-    
-    QStringList parts = input.split(QRegExp("\\s+"), QString::SkipEmptyParts);
-    // Qt 5.12兼容：如果上面的方法不行，使用下面的
-    // QStringList parts = input.split(' ', QString::SkipEmptyParts);
-    
-    if (parts.isEmpty()) {
-        isValid = false;
-        return result;
+    // 按空白切分，允许数字和字符串，超过元素上限的部分忽略
+    QStringList result = InputTokenizer::tokenize(QStringView(input), currentMaxElements());
+    isValid = !result.isEmpty();
+    return result;
+}
+
+int MainWindow::currentMaxElements() const
+{
+    if (currentType == 0) {
+        return arrayWidget->maxElements();
     }
-    
-    // 检查每个部分是否都是有效的数字或字符串
-    for (const QString &part : parts) {
-        QString trimmed = part.trimmed();
-        if (!trimmed.isEmpty()) {
-            // 允许数字和字符串
-            result << trimmed;
-        }
+    return currentType == 1 ? linkedListWidget->maxElements() : unrolledListWidget->maxElements();
+}
+
+TraceRecord::Structure MainWindow::structureOf(int type) const
+{
+    if (type == 0) {
+        return arrayWidget->isRingMode() ? TraceRecord::RingArray : TraceRecord::Array;
     }
-    
-    if (result.size() > 20) {
-        result = result.mid(0, 20); // 限制最大20个元素
+    return type == 1 ? TraceRecord::LinkedList : TraceRecord::UnrolledList;
+}
+
+void MainWindow::recordOperation(TraceRecord::Type type, int index, const QString &value)
+{
+    if (recorder.isRecording()) {
+        recorder.recordOperation(structureOf(currentType), type, index, value);
     }
-    
-    isValid = result.size() > 0;
-    return result;
 }
 
 void MainWindow::onInitTextChanged()
 {
+    // 只统计个数，不生成字符串；真正切分在点击初始化时进行
     QString text = initEdit->text();
-    bool isValid = false;
-    QStringList values = parseInputString(text, isValid);
+    int count = InputTokenizer::count(QStringView(text), currentMaxElements());
     
     if (text.isEmpty()) {
         initHintLabel->setText("");
         initHintLabel->setStyleSheet("color: gray;");
-    } else if (isValid) {
-        initHintLabel->setText(QString("有效: %1 个元素").arg(values.size()));
+    } else if (count > 0) {
+        initHintLabel->setText(QString("有效: %1 个元素").arg(count));
         initHintLabel->setStyleSheet("color: green;");
     } else {
         initHintLabel->setText("输入格式错误");
@@ -227,6 +310,7 @@ void MainWindow::onInitTextChanged()
 
 void MainWindow::onInitClicked()
 {
+    initValidateTimer->stop();
     QString input = initEdit->text();
     bool isValid = false;
     QStringList values = parseInputString(input, isValid);
@@ -238,20 +322,21 @@ void MainWindow::onInitClicked()
     
     if (currentType == 0) {
         arrayWidget->initialize(values);
-    } else {
+    } else if (currentType == 1) {
         linkedListWidget->initialize(values);
+    } else {
+        unrolledListWidget->initialize(values);
+    }
+    if (recorder.isRecording()) {
+        recorder.recordInit(structureOf(currentType), values);
     }
     
     // 强制刷新当前显示的组件
-    if (currentType == 0) {
-        arrayWidget->update();
-        arrayWidget->repaint();
-    } else {
-        linkedListWidget->update();
-        linkedListWidget->repaint();
-    }
+    currentWidget->update();
+    currentWidget->repaint();
     
     updateIndexRange();
+    updateCostLabel();
     initEdit->clear();
     initHintLabel->setText("");
 }
@@ -264,8 +349,8 @@ void MainWindow::updateIndexRange()
         maxIndex = arrayWidget->getSize() - 1;
         if (maxIndex < 0) maxIndex = 0;
     } else {
-        // 链表：可以在-1到size之间插入（-1表示开头，0到size-1表示在对应索引之后，size表示末尾）
-        maxIndex = linkedListWidget->getSize();
+        // 链表和展开链表：可以在-1到size之间插入（-1表示开头，0到size-1表示在对应索引之后，size表示末尾）
+        maxIndex = currentType == 1 ? linkedListWidget->getSize() : unrolledListWidget->getSize();
         if (maxIndex < -1) maxIndex = -1;
     }
     
@@ -286,6 +371,23 @@ void MainWindow::updateIndexRange()
     }
 }
 
+void MainWindow::updateCostLabel()
+{
+    OpCost last;
+    OpCost total;
+    if (currentType == 0) {
+        last = arrayWidget->lastCost();
+        total = arrayWidget->totalCost();
+    } else if (currentType == 1) {
+        last = linkedListWidget->lastCost();
+        total = linkedListWidget->totalCost();
+    } else {
+        last = unrolledListWidget->lastCost();
+        total = unrolledListWidget->totalCost();
+    }
+    costLabel->setText(QString("本次：%1 ｜ 累计：%2").arg(formatCost(last), formatCost(total)));
+}
+
 void MainWindow::onInsertClicked()
 {
     QString value = valueEdit->text();
@@ -300,16 +402,30 @@ void MainWindow::onInsertClicked()
         // 数组：在索引index之后插入（动态扩展）
         int insertIndex = index >= arrayWidget->getSize() ? -1 : index;
         if (!arrayWidget->insertElement(insertIndex, value)) {
-            QMessageBox::warning(this, "警告", "插入失败！数组元素数量已达上限(30个)。");
+            QMessageBox::warning(this, "警告", QString("插入失败！数组元素数量已达上限(%1个)。").arg(arrayWidget->maxElements()));
         } else {
+            recordOperation(TraceRecord::Insert, insertIndex, value);
             updateIndexRange();
         }
-    } else {
+    } else if (currentType == 1) {
         // 链表：在索引index之后插入（index=-1表示开头，index>=0表示在index之后）
-        linkedListWidget->addElement(index, value);
-        updateIndexRange();
+        if (!linkedListWidget->addElement(index, value)) {
+            QMessageBox::warning(this, "警告", QString("插入失败！链表节点数量已达上限(%1个)。").arg(linkedListWidget->maxElements()));
+        } else {
+            recordOperation(TraceRecord::Insert, index, value);
+            updateIndexRange();
+        }
+    } else {
+        // 展开链表：索引含义与链表相同
+        if (!unrolledListWidget->addElement(index, value)) {
+            QMessageBox::warning(this, "警告", QString("插入失败！展开链表元素数量已达上限(%1个)。").arg(unrolledListWidget->maxElements()));
+        } else {
+            recordOperation(TraceRecord::Insert, index, value);
+            updateIndexRange();
+        }
     }
     
+    updateCostLabel();
     valueEdit->clear();
 }
 
@@ -321,15 +437,20 @@ void MainWindow::onDeleteClicked()
         if (!arrayWidget->deleteElement(index)) {
             QMessageBox::warning(this, "警告", "删除失败！索引超出范围。");
         } else {
+            recordOperation(TraceRecord::Delete, index);
             updateIndexRange();
         }
     } else {
-        if (!linkedListWidget->deleteElement(index)) {
+        bool deleted = currentType == 1 ? linkedListWidget->deleteElement(index)
+                                        : unrolledListWidget->deleteElement(index);
+        if (!deleted) {
             QMessageBox::warning(this, "警告", "删除失败！索引超出范围。");
         } else {
+            recordOperation(TraceRecord::Delete, index);
             updateIndexRange();
         }
     }
+    updateCostLabel();
 }
 
 void MainWindow::onArrayElementClicked(int index)
@@ -345,17 +466,16 @@ void MainWindow::onArrayElementClicked(int index)
     if (ret == 0) {
         // 删除
         if (arrayWidget->deleteElement(index)) {
+            recordOperation(TraceRecord::Delete, index);
             updateIndexRange();
+            updateCostLabel();
         } else {
             QMessageBox::warning(this, "警告", "删除失败！");
         }
     } else if (ret == 1) {
         // 修改
-        QStringList values = arrayWidget->getValues();
-        if (index < values.size()) {
-            valueEdit->setText(values[index]);
-            valueEdit->setFocus();
-        }
+        valueEdit->setText(arrayWidget->getValue(index));
+        valueEdit->setFocus();
     }
 }
 
@@ -372,17 +492,42 @@ void MainWindow::onLinkedListElementClicked(int index)
     if (ret == 0) {
         // 删除
         if (linkedListWidget->deleteElement(index)) {
+            recordOperation(TraceRecord::Delete, index);
             updateIndexRange();
+            updateCostLabel();
         } else {
             QMessageBox::warning(this, "警告", "删除失败！");
         }
     } else if (ret == 1) {
         // 修改
-        QStringList values = linkedListWidget->getValues();
-        if (index < values.size()) {
-            valueEdit->setText(values[index]);
-            valueEdit->setFocus();
+        valueEdit->setText(linkedListWidget->getValue(index));
+        valueEdit->setFocus();
+    }
+}
+
+void MainWindow::onUnrolledListElementClicked(int index)
+{
+    // 点击元素时，自动选中该索引并高亮显示
+    indexSpinBox->setValue(index);
+    
+    // 询问是否删除
+    int ret = QMessageBox::question(this, "操作选择", 
+                                     QString("您点击了索引 %1 的元素\n\n选择操作：").arg(index),
+                                     "删除", "修改", "取消", 0, 2);
+    
+    if (ret == 0) {
+        // 删除
+        if (unrolledListWidget->deleteElement(index)) {
+            recordOperation(TraceRecord::Delete, index);
+            updateIndexRange();
+            updateCostLabel();
+        } else {
+            QMessageBox::warning(this, "警告", "删除失败！");
         }
+    } else if (ret == 1) {
+        // 修改
+        valueEdit->setText(unrolledListWidget->getValue(index));
+        valueEdit->setFocus();
     }
 }
 
@@ -396,16 +541,378 @@ void MainWindow::onModifyClicked()
     
     int index = indexSpinBox->value();
     
+    bool modified = false;
+    if (currentType == 0) {
+        modified = arrayWidget->modifyElement(index, value);
+    } else if (currentType == 1) {
+        modified = linkedListWidget->modifyElement(index, value);
+    } else {
+        modified = unrolledListWidget->modifyElement(index, value);
+    }
+    if (!modified) {
+        QMessageBox::warning(this, "警告", "修改失败！索引超出范围。");
+    } else {
+        recordOperation(TraceRecord::Modify, index, value);
+    }
+    updateCostLabel();
+    
+    valueEdit->clear();
+}
+
+bool MainWindow::parseOperations(const QString &input, LinearOpList &ops, int &errorLine)
+{
+    // 每行一个操作：insert/i/插入 索引 值、delete/d/删除 索引、modify/m/修改 索引 值
+    // 空行和以 # 开头的行忽略
+    ops.clear();
+    errorLine = 0;
+    
+    QStringList lines = input.split('\n');
+    for (int i = 0; i < lines.size(); ++i) {
+        QString line = lines[i].trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        
+        QStringList parts = line.split(QRegExp("\\s+"), QString::SkipEmptyParts);
+        QString command = parts[0].toLower();
+        bool indexOk = false;
+        int index = parts.size() > 1 ? parts[1].toInt(&indexOk) : 0;
+        
+        LinearOp op;
+        if (command == "insert" || command == "i" || command == "插入") {
+            op.type = LinearOp::Insert;
+        } else if (command == "delete" || command == "d" || command == "删除") {
+            op.type = LinearOp::Delete;
+        } else if (command == "modify" || command == "m" || command == "修改") {
+            op.type = LinearOp::Modify;
+        } else {
+            errorLine = i + 1;
+            return false;
+        }
+        
+        // 删除只需要索引，插入和修改还需要值
+        bool needsValue = op.type != LinearOp::Delete;
+        if (!indexOk || parts.size() != (needsValue ? 3 : 2)) {
+            errorLine = i + 1;
+            return false;
+        }
+        
+        op.index = index;
+        if (needsValue) {
+            op.value = parts[2];
+        }
+        ops.append(op);
+    }
+    
+    return !ops.isEmpty();
+}
+
+void MainWindow::onBatchClicked()
+{
+    bool ok = false;
+    QString text = QInputDialog::getMultiLineText(this, "批量操作",
+                                                  "每行一个操作，例如：\n"
+                                                  "insert 0 A（在索引0之后插入A，-1 表示开头）\n"
+                                                  "delete 2\n"
+                                                  "modify 1 B",
+                                                  QString(), &ok);
+    if (!ok || text.trimmed().isEmpty()) {
+        return;
+    }
+    
+    LinearOpList ops;
+    int errorLine = 0;
+    if (!parseOperations(text, ops, errorLine)) {
+        if (errorLine > 0) {
+            QMessageBox::warning(this, "警告", QString("第 %1 行格式错误！").arg(errorLine));
+        } else {
+            QMessageBox::warning(this, "警告", "请输入至少一个操作！");
+        }
+        return;
+    }
+    
+    int applied = 0;
     if (currentType == 0) {
-        if (!arrayWidget->modifyElement(index, value)) {
-            QMessageBox::warning(this, "警告", "修改失败！索引超出范围。");
+        applied = arrayWidget->applyBatch(ops);
+    } else if (currentType == 1) {
+        applied = linkedListWidget->applyBatch(ops);
+    } else {
+        applied = unrolledListWidget->applyBatch(ops);
+    }
+    updateIndexRange();
+    updateCostLabel();
+    
+    // 逐条录制；失败的操作回放时同样失败，不影响结果
+    for (const LinearOp &op : ops) {
+        TraceRecord::Type type = op.type == LinearOp::Insert ? TraceRecord::Insert
+                               : op.type == LinearOp::Delete ? TraceRecord::Delete : TraceRecord::Modify;
+        recordOperation(type, op.index, op.value);
+    }
+    
+    if (applied < ops.size()) {
+        QMessageBox::warning(this, "警告", QString("共 %1 个操作，其中 %2 个失败（索引超出范围或已达元素上限）。")
+                             .arg(ops.size()).arg(ops.size() - applied));
+    }
+}
+
+void MainWindow::onRecordToggled(bool checked)
+{
+    if (!checked) {
+        int count = recorder.recordCount();
+        recorder.close();
+        recordButton->setText("录制");
+        QMessageBox::information(this, "录制", QString("已录制 %1 个操作。").arg(count));
+        return;
+    }
+    
+    QString path = QFileDialog::getSaveFileName(this, "录制操作轨迹", QString(), "操作轨迹 (*.trace);;所有文件 (*)");
+    if (path.isEmpty() || !recorder.open(path)) {
+        if (!path.isEmpty()) {
+            QMessageBox::warning(this, "警告", QString("无法创建文件：%1").arg(recorder.errorString()));
+        }
+        recordButton->blockSignals(true);
+        recordButton->setChecked(false);
+        recordButton->blockSignals(false);
+        return;
+    }
+    recordButton->setText("停止录制");
+}
+
+void MainWindow::onReplayClicked()
+{
+    if (replayer->isRunning()) {
+        replayer->stop();
+        return;
+    }
+    
+    QString path = QFileDialog::getOpenFileName(this, "回放操作轨迹", QString(), "操作轨迹 (*.trace);;所有文件 (*)");
+    if (path.isEmpty()) {
+        return;
+    }
+    
+    TraceRecordList records;
+    int errorLine = 0;
+    if (!TraceRecorder::load(path, records, errorLine)) {
+        if (errorLine > 0) {
+            QMessageBox::warning(this, "警告", QString("轨迹文件第 %1 行格式错误！").arg(errorLine));
+        } else {
+            QMessageBox::warning(this, "警告", "无法打开轨迹文件！");
+        }
+        return;
+    }
+    if (records.isEmpty()) {
+        QMessageBox::warning(this, "警告", "轨迹文件中没有操作！");
+        return;
+    }
+    
+    // 倍速为 0 表示不限速
+    QStringList speedNames;
+    speedNames << "1× (原速)" << "2×" << "10×" << "100×" << "不限速";
+    const double speeds[] = { 1.0, 2.0, 10.0, 100.0, 0.0 };
+    bool ok = false;
+    QString choice = QInputDialog::getItem(this, "回放", "回放速度：", speedNames, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+    double speed = speeds[qMax(0, speedNames.indexOf(choice))];
+    
+    int ret = QMessageBox::question(this, "回放", "回放时是否播放动画？",
+                                    "播放动画", "不播放", "取消", 0, 2);
+    if (ret == 2) {
+        return;
+    }
+    
+    if (recordButton->isChecked()) {
+        recordButton->setChecked(false);
+    }
+    // 累计开销从回放开始计算，结束时与耗时一起显示，便于比较不同结构执行同一轨迹的开销
+    arrayWidget->resetCostCounters();
+    linkedListWidget->resetCostCounters();
+    unrolledListWidget->resetCostCounters();
+    setEditingEnabled(false);
+    replayButton->setText("停止回放");
+    replayer->start(records, speed, ret == 0);
+}
+
+void MainWindow::onReplayStructureChanged(int structure)
+{
+    // 切换显示的组件，轨迹中的初始化和操作作用于对应的结构
+    if (structure == TraceRecord::Array || structure == TraceRecord::RingArray) {
+        typeComboBox->setCurrentIndex(0);
+        ringCheckBox->setChecked(structure == TraceRecord::RingArray);
+    } else {
+        typeComboBox->setCurrentIndex(structure == TraceRecord::LinkedList ? 1 : 2);
+    }
+}
+
+void MainWindow::onReplayFinished(int applied, int failed, qint64 elapsedMs)
+{
+    setEditingEnabled(true);
+    replayButton->setText("回放");
+    updateIndexRange();
+    updateCostLabel();
+    
+    int total = applied + failed;
+    double opsPerSecond = elapsedMs > 0 ? total * 1000.0 / elapsedMs : 0.0;
+    QString message = QString("回放 %1 个操作（%2 个失败），用时 %3 ms，%4 次操作/秒")
+                      .arg(total).arg(failed).arg(elapsedMs).arg(opsPerSecond, 0, 'f', 1);
+    if (elapsedMs == 0) {
+        message = QString("回放 %1 个操作（%2 个失败），用时不足 1 ms").arg(total).arg(failed);
+    }
+    OpCost cost = currentType == 0 ? arrayWidget->totalCost()
+                : currentType == 1 ? linkedListWidget->totalCost() : unrolledListWidget->totalCost();
+    message += QString("\n开销：%1").arg(formatCost(cost));
+    QMessageBox::information(this, "回放完成", message);
+}
+
+void MainWindow::setEditingEnabled(bool enabled)
+{
+    typeComboBox->setEnabled(enabled);
+    ringCheckBox->setEnabled(enabled && currentType == 0);
+    initButton->setEnabled(enabled);
+    insertButton->setEnabled(enabled);
+    deleteButton->setEnabled(enabled);
+    modifyButton->setEnabled(enabled);
+    batchButton->setEnabled(enabled);
+    recordButton->setEnabled(enabled);
+    inputGroup->setEnabled(enabled);  // 包括从文件加载按钮
+}
+
+void MainWindow::onLoadFileClicked()
+{
+    if (importer) {
+        return;
+    }
+    
+    QString path = QFileDialog::getOpenFileName(this, "从文件加载初始化数据", QString(),
+                                                "文本文件 (*.txt *.csv);;所有文件 (*)");
+    if (path.isEmpty()) {
+        return;
+    }
+    
+    importType = currentType;
+    importedCount = 0;
+    
+    // 切分在工作线程进行，每块值通过排队连接送回界面线程
+    importer = new BulkImporter(path, currentMaxElements());
+    importThread = new QThread(this);
+    importer->moveToThread(importThread);
+    connect(importThread, SIGNAL(started()), importer, SLOT(run()));
+    connect(importer, SIGNAL(chunkReady(QStringList)), this, SLOT(onImportChunk(QStringList)));
+    connect(importer, SIGNAL(progress(qint64,qint64)), this, SLOT(onImportProgress(qint64,qint64)));
+    connect(importer, SIGNAL(finished(int,bool)), this, SLOT(onImportFinished(int,bool)));
+    connect(importer, SIGNAL(failed(QString)), this, SLOT(onImportFailed(QString)));
+    
+    // 非模态：模态进度框的 setValue 会重入事件循环
+    importProgress = new QProgressDialog("正在加载文件...", "取消", 0, 1000, this);
+    importProgress->setMinimumDuration(300);
+    importProgress->setAutoClose(false);
+    importProgress->setAutoReset(false);
+    connect(importProgress, SIGNAL(canceled()), this, SLOT(onImportCanceled()));
+    
+    setEditingEnabled(false);
+    replayButton->setEnabled(false);
+    importThread->start();
+}
+
+void MainWindow::onImportChunk(const QStringList &values)
+{
+    // 第一块重新初始化，之后的块追加到末尾
+    if (importType == 0) {
+        if (importedCount == 0) {
+            arrayWidget->initialize(values);
+        } else {
+            arrayWidget->appendValues(values);
+        }
+    } else if (importType == 1) {
+        if (importedCount == 0) {
+            linkedListWidget->initialize(values);
+        } else {
+            linkedListWidget->appendValues(values);
         }
     } else {
-        if (!linkedListWidget->modifyElement(index, value)) {
-            QMessageBox::warning(this, "警告", "修改失败！索引超出范围。");
+        if (importedCount == 0) {
+            unrolledListWidget->initialize(values);
+        } else {
+            unrolledListWidget->appendValues(values);
         }
     }
+    importedCount += values.size();
     
-    valueEdit->clear();
+    if (importer) {
+        importer->chunkConsumed();
+    }
+}
+
+void MainWindow::onImportProgress(qint64 bytesRead, qint64 totalBytes)
+{
+    if (importProgress && totalBytes > 0) {
+        importProgress->setValue(static_cast<int>(bytesRead * 1000 / totalBytes));
+    }
 }
 
+void MainWindow::onImportCanceled()
+{
+    if (importer) {
+        importer->cancel();
+    }
+}
+
+void MainWindow::onImportFinished(int count, bool cancelled)
+{
+    Q_UNUSED(count);
+    finishImport();
+    updateIndexRange();
+    updateCostLabel();
+    
+    if (importedCount == 0) {
+        if (!cancelled) {
+            QMessageBox::warning(this, "警告", "文件中没有可用的数据！");
+        }
+        return;
+    }
+    
+    // 录制时把加载结果记为一次初始化
+    if (recorder.isRecording()) {
+        QStringList values;
+        if (importType == 0) {
+            values = arrayWidget->getValues();
+        } else if (importType == 1) {
+            values = linkedListWidget->getValues();
+        } else {
+            values = unrolledListWidget->getValues();
+        }
+        recorder.recordInit(structureOf(importType), values);
+    }
+    
+    initHintLabel->setStyleSheet("color: green;");
+    if (cancelled) {
+        initHintLabel->setText(QString("已取消，加载了 %1 个元素").arg(importedCount));
+    } else {
+        initHintLabel->setText(QString("已从文件加载 %1 个元素").arg(importedCount));
+    }
+}
+
+void MainWindow::onImportFailed(const QString &message)
+{
+    finishImport();
+    updateIndexRange();
+    QMessageBox::warning(this, "警告", QString("加载文件失败：%1").arg(message));
+}
+
+void MainWindow::finishImport()
+{
+    importThread->quit();
+    importThread->wait();
+    delete importer;
+    importer = nullptr;
+    importThread->deleteLater();
+    importThread = nullptr;
+    
+    if (importProgress) {
+        importProgress->deleteLater();
+        importProgress = nullptr;
+    }
+    setEditingEnabled(true);
+    replayButton->setEnabled(true);
+}
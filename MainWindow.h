@@ -11,11 +11,20 @@
 #include <QLabel>
 #include <QGroupBox>
 #include <QSpinBox>
+#include <QCheckBox>
 #include <QRegExp>
 #include <QStringList>
 #include <QShowEvent>
+#include <QTimer>
+#include <QThread>
+#include <QProgressDialog>
 #include "ArrayWidget.h"
 #include "LinkedListWidget.h"
+#include "UnrolledListWidget.h"
+#include "OperationTrace.h"
+#include "BulkImporter.h"
+#include "InputTokenizer.h"
+#include "TraceReplayer.h"
 
 class MainWindow : public QMainWindow
 {
@@ -30,10 +39,25 @@ private slots:
     void onInsertClicked();
     void onDeleteClicked();
     void onModifyClicked();
+    void onBatchClicked();
     void onTypeChanged(int index);
     void onArrayElementClicked(int index);
     void onLinkedListElementClicked(int index);
-    void onInitTextChanged();
+    void onUnrolledListElementClicked(int index);
+    void onInitTextChanged();  // 输入停止一段时间后才校验，见 initValidateTimer
+    void onHudToggled(bool checked);
+    void onRingToggled(bool checked);
+    void onOverviewToggled(bool checked);
+    void onRecordToggled(bool checked);
+    void onReplayClicked();
+    void onReplayStructureChanged(int structure);
+    void onReplayFinished(int applied, int failed, qint64 elapsedMs);
+    void onLoadFileClicked();
+    void onImportChunk(const QStringList &values);
+    void onImportProgress(qint64 bytesRead, qint64 totalBytes);
+    void onImportFinished(int count, bool cancelled);
+    void onImportFailed(const QString &message);
+    void onImportCanceled();
 
 protected:
     void showEvent(QShowEvent *event) override;
@@ -42,7 +66,14 @@ private:
     void setupUI();
     void setupConnections();
     QStringList parseInputString(const QString &input, bool &isValid);
+    bool parseOperations(const QString &input, LinearOpList &ops, int &errorLine);
+    int currentMaxElements() const;
+    TraceRecord::Structure structureOf(int type) const;  // 类型下拉框的序号对应的轨迹结构
+    void recordOperation(TraceRecord::Type type, int index, const QString &value = QString());
+    void setEditingEnabled(bool enabled);  // 回放和导入期间禁止手动操作
+    void finishImport();  // 结束工作线程并释放导入相关对象
     void updateIndexRange();
+    void updateCostLabel();  // 显示当前结构最近一次操作和累计的开销
     
     QWidget *centralWidget;
     QVBoxLayout *mainLayout;
@@ -55,6 +86,12 @@ private:
     QPushButton *insertButton;
     QPushButton *deleteButton;
     QPushButton *modifyButton;
+    QPushButton *batchButton;  // 粘贴多行操作批量执行
+    QPushButton *recordButton;  // 录制操作轨迹（可切换）
+    QPushButton *replayButton;  // 回放操作轨迹，回放中再次点击停止
+    QCheckBox *ringCheckBox;  // 数组的环形缓冲区模式，只在选中数组时可用
+    QCheckBox *overviewCheckBox;  // 数组和链表的概览模式，选中展开链表时不可用
+    QCheckBox *hudCheckBox;  // 性能统计面板开关
     
     // 输入面板
     QGroupBox *inputGroup;
@@ -66,19 +103,36 @@ private:
     QLabel *initLabel;
     QLineEdit *initEdit;
     QLabel *initHintLabel;
+    QTimer *initValidateTimer;  // 输入提示的防抖定时器
+    QPushButton *loadFileButton;  // 从文件加载初始化数据
     
     // 操作输入
     QLabel *valueLabel;
     QLineEdit *valueEdit;
     QLabel *indexLabel;
     QSpinBox *indexSpinBox;
+    QLabel *costLabel;  // 操作开销（移动、重新分配、指针步数、节点分配）
     
     // 可视化组件
     ArrayWidget *arrayWidget;
     LinkedListWidget *linkedListWidget;
+    UnrolledListWidget *unrolledListWidget;
     QWidget *currentWidget;
     
-    int currentType; // 0: 数组, 1: 链表
+    // 操作轨迹：录制经由本窗口执行的操作，回放时直接驱动可视化组件
+    TraceRecorder recorder;
+    TraceReplayer *replayer;
+    
+    // 文件导入：工作线程切分，界面线程按块追加到目标组件
+    QThread *importThread;
+    BulkImporter *importer;
+    QProgressDialog *importProgress;
+    int importType;  // 导入开始时选中的结构，导入期间不会改变
+    int importedCount;
+    
+    int currentType; // 0: 数组, 1: 链表, 2: 展开链表
+    
+    static const int INIT_VALIDATE_DELAY_MS = 200;  // 最后一次输入后多久更新提示
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,134 @@
+#include "PerfHud.h"
+#include <QFont>
+#include <QFontMetrics>
+#include <QStringList>
+
+PerfHud::PerfHud()
+    : enabled(false)
+    , lastFrameNs(-1)
+    , drawnElements(0)
+    , skippedElements(0)
+    , repaintRatio(0.0)
+{
+    resetStats();
+}
+
+void PerfHud::setEnabled(bool on)
+{
+    if (on && !enabled) {
+        resetStats();
+        frameClock.start();
+    }
+    enabled = on;
+}
+
+void PerfHud::resetStats()
+{
+    for (int m = 0; m < MetricCount; ++m) {
+        stats[m].last = 0;
+        stats[m].sum = 0;
+        stats[m].count = 0;
+        stats[m].cursor = 0;
+        for (int i = 0; i < WINDOW; ++i) {
+            stats[m].samples[i] = 0;
+        }
+    }
+    lastFrameNs = -1;
+    drawnElements = 0;
+    skippedElements = 0;
+    repaintRatio = 0.0;
+}
+
+void PerfHud::addSample(Metric metric, qint64 nsecs)
+{
+    Stat &stat = stats[metric];
+    // 环形缓冲区维护最近 WINDOW 个样本的和
+    if (stat.count == WINDOW) {
+        stat.sum -= stat.samples[stat.cursor];
+    } else {
+        stat.count++;
+    }
+    stat.samples[stat.cursor] = nsecs;
+    stat.sum += nsecs;
+    stat.cursor = (stat.cursor + 1) % WINDOW;
+    stat.last = nsecs;
+}
+
+void PerfHud::markAnimationFrame()
+{
+    if (!enabled) {
+        return;
+    }
+    
+    qint64 now = frameClock.nsecsElapsed();
+    // 只统计同一段动画内的帧间隔，两段动画之间的空闲时间不计入
+    if (lastFrameNs >= 0 && now - lastFrameNs < ANIMATION_IDLE_NS) {
+        addSample(FrameGapMetric, now - lastFrameNs);
+    }
+    lastFrameNs = now;
+}
+
+void PerfHud::setElementCounts(int drawn, int skipped)
+{
+    drawnElements = drawn;
+    skippedElements = skipped;
+}
+
+void PerfHud::setRepaintArea(qint64 dirtyPixels, qint64 totalPixels)
+{
+    repaintRatio = totalPixels > 0 ? double(dirtyPixels) / totalPixels : 0.0;
+}
+
+double PerfHud::averageMs(Metric metric) const
+{
+    const Stat &stat = stats[metric];
+    return stat.count > 0 ? stat.sum / 1e6 / stat.count : 0.0;
+}
+
+double PerfHud::lastMs(Metric metric) const
+{
+    return stats[metric].last / 1e6;
+}
+
+QRect PerfHud::overlayRect(const QRect &bounds) const
+{
+    return QRect(bounds.left() + 4, bounds.top() + 4, 300, 112);
+}
+
+void PerfHud::paint(QPainter &painter, const QRect &bounds) const
+{
+    QStringList lines;
+    lines << QString("paint   last %1 ms  avg %2 ms")
+             .arg(lastMs(PaintMetric), 0, 'f', 2).arg(averageMs(PaintMetric), 0, 'f', 2);
+    lines << QString("layout  last %1 ms  avg %2 ms")
+             .arg(lastMs(LayoutMetric), 0, 'f', 2).arg(averageMs(LayoutMetric), 0, 'f', 2);
+    
+    // 最近一帧距今超过空闲阈值时不再显示帧率
+    bool animating = lastFrameNs >= 0 && frameClock.nsecsElapsed() - lastFrameNs < ANIMATION_IDLE_NS;
+    double gapMs = averageMs(FrameGapMetric);
+    QString fps = (animating && gapMs > 0.0) ? QString::number(1000.0 / gapMs, 'f', 1) : QString("-");
+    lines << QString("frame   last %1 ms  avg %2 ms  fps %3")
+             .arg(lastMs(FrameGapMetric), 0, 'f', 1).arg(gapMs, 0, 'f', 1).arg(fps);
+    lines << QString("drawn   %1  skipped %2").arg(drawnElements).arg(skippedElements);
+    lines << QString("repaint %1 % of widget").arg(repaintRatio * 100.0, 0, 'f', 1);
+    lines << QString("values  %1 refs / %2 unique  x%3")
+             .arg(valueStats.references).arg(valueStats.uniqueValues).arg(valueStats.dedupRatio(), 0, 'f', 1);
+    
+    QRect box = overlayRect(bounds);
+    
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 170));
+    painter.drawRect(box);
+    
+    QFont hudFont("Courier New", 9);
+    painter.setFont(hudFont);
+    painter.setPen(QColor(120, 255, 120));
+    int lineHeight = QFontMetrics(hudFont).height();
+    for (int i = 0; i < lines.size(); ++i) {
+        painter.drawText(QRect(box.left() + 6, box.top() + 4 + i * lineHeight, box.width() - 12, lineHeight),
+                         Qt::AlignLeft | Qt::AlignVCenter, lines[i]);
+    }
+    painter.restore();
+}
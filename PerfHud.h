@@ -0,0 +1,86 @@
+#ifndef PERFHUD_H
+#define PERFHUD_H
+
+#include <QPainter>
+#include <QRect>
+#include <QElapsedTimer>
+#include "ValuePool.h"
+
+// 性能统计面板：记录绘制、布局耗时和动画帧间隔，叠加显示在组件左上角
+// 面板关闭时所有统计入口只做一次布尔判断，不读取时钟
+class PerfHud
+{
+public:
+    enum Metric {
+        PaintMetric,     // paintEvent 耗时
+        LayoutMetric,    // updateLayout 耗时
+        FrameGapMetric,  // 相邻两个动画帧的间隔
+        MetricCount
+    };
+    
+    // 作用域计时：构造时开始，析构时记录一次样本
+    class Scope
+    {
+    public:
+        Scope(PerfHud &hud, Metric metric)
+            : hud(hud), metric(metric), active(hud.isEnabled())
+        {
+            if (active) {
+                timer.start();
+            }
+        }
+        ~Scope()
+        {
+            if (active) {
+                hud.addSample(metric, timer.nsecsElapsed());
+            }
+        }
+        
+    private:
+        PerfHud &hud;
+        Metric metric;
+        bool active;
+        QElapsedTimer timer;
+    };
+    
+    PerfHud();
+    
+    void setEnabled(bool enabled);  // 打开时清空历史统计
+    bool isEnabled() const { return enabled; }
+    
+    void addSample(Metric metric, qint64 nsecs);
+    void markAnimationFrame();  // 在每次动画进度更新时调用
+    void setElementCounts(int drawn, int skipped);
+    void setRepaintArea(qint64 dirtyPixels, qint64 totalPixels);  // 本次 paintEvent 的重绘面积
+    void setValuePoolStats(const ValuePoolStats &stats) { valueStats = stats; }
+    
+    QRect overlayRect(const QRect &bounds) const;
+    void paint(QPainter &painter, const QRect &bounds) const;
+
+private:
+    static const int WINDOW = 60;  // 滚动平均的样本数
+    static const qint64 ANIMATION_IDLE_NS = 250000000;  // 超过该间隔视为动画已停止
+    
+    struct Stat {
+        qint64 last;
+        qint64 samples[WINDOW];
+        qint64 sum;
+        int count;
+        int cursor;
+    };
+    
+    void resetStats();
+    double averageMs(Metric metric) const;
+    double lastMs(Metric metric) const;
+    
+    bool enabled;
+    Stat stats[MetricCount];
+    QElapsedTimer frameClock;
+    qint64 lastFrameNs;  // 上一次动画帧的时刻，-1 表示尚无
+    int drawnElements;
+    int skippedElements;
+    double repaintRatio;  // 重绘面积占组件面积的比例
+    ValuePoolStats valueStats;  // 共用值池的去重情况
+};
+
+#endif // PERFHUD_H
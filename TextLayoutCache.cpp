@@ -0,0 +1,62 @@
+#include "TextLayoutCache.h"
+#include <QFontMetrics>
+
+TextLayoutCache::TextLayoutCache()
+    : maxWidth(0)
+{
+}
+
+void TextLayoutCache::setFont(const QFont &font)
+{
+    if (font == textFont) {
+        return;
+    }
+    textFont = font;
+    clear();
+}
+
+void TextLayoutCache::setMaxWidth(int width)
+{
+    if (width == maxWidth) {
+        return;
+    }
+    maxWidth = width;
+    clear();
+}
+
+void TextLayoutCache::clear()
+{
+    entries.clear();
+}
+
+const QStaticText &TextLayoutCache::layout(const QString &text)
+{
+    QHash<QString, QStaticText>::const_iterator it = entries.constFind(text);
+    if (it != entries.constEnd()) {
+        return it.value();
+    }
+    
+    if (entries.size() >= MAX_ENTRIES) {
+        entries.clear();
+    }
+    
+    // 只在首次出现时计算省略和排版
+    QString shown = text;
+    if (maxWidth > 0) {
+        shown = QFontMetrics(textFont).elidedText(text, Qt::ElideRight, maxWidth);
+    }
+    QStaticText staticText(shown);
+    staticText.setTextFormat(Qt::PlainText);
+    staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    staticText.prepare(QTransform(), textFont);
+    return entries.insert(text, staticText).value();
+}
+
+void TextLayoutCache::draw(QPainter &painter, const QRectF &rect, const QString &text)
+{
+    const QStaticText &staticText = layout(text);
+    QSizeF textSize = staticText.size();
+    painter.setFont(textFont);
+    painter.drawStaticText(QPointF(rect.center().x() - textSize.width() / 2,
+                                   rect.center().y() - textSize.height() / 2), staticText);
+}
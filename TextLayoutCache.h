@@ -0,0 +1,35 @@
+#ifndef TEXTLAYOUTCACHE_H
+#define TEXTLAYOUTCACHE_H
+
+#include <QFont>
+#include <QHash>
+#include <QPainter>
+#include <QStaticText>
+#include <QString>
+
+// 文本排版缓存：按字符串缓存省略后的 QStaticText，避免每帧重复排版
+// 同一缓存内的文本共用一种字体和最大宽度，任一变化时清空缓存
+class TextLayoutCache
+{
+public:
+    TextLayoutCache();
+    
+    void setFont(const QFont &font);
+    void setMaxWidth(int width);  // 超出宽度的文本以省略号结尾
+    const QFont &font() const { return textFont; }
+    int size() const { return entries.size(); }
+    void clear();
+    
+    void draw(QPainter &painter, const QRectF &rect, const QString &text);  // 在 rect 中居中绘制
+
+private:
+    static const int MAX_ENTRIES = 4096;  // 超过后整体清空，防止滚动浏览大量元素时无限增长
+    
+    const QStaticText &layout(const QString &text);
+    
+    QFont textFont;
+    int maxWidth;
+    QHash<QString, QStaticText> entries;
+};
+
+#endif // TEXTLAYOUTCACHE_H
@@ -0,0 +1,169 @@
+#include "TraceReplayer.h"
+
+TraceReplayer::TraceReplayer(ArrayWidget *arrayWidget, LinkedListWidget *linkedListWidget,
+                             UnrolledListWidget *unrolledListWidget, QObject *parent)
+    : QObject(parent)
+    , arrayWidget(arrayWidget)
+    , linkedListWidget(linkedListWidget)
+    , unrolledListWidget(unrolledListWidget)
+    , position(0)
+    , failed(0)
+    , speed(1.0)
+    , running(false)
+    , currentStructure(-1)
+    , arrayAnimations(true)
+    , listAnimations(true)
+    , unrolledAnimations(true)
+{
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, SIGNAL(timeout()), this, SLOT(onTimeout()));
+}
+
+void TraceReplayer::start(const TraceRecordList &trace, double replaySpeed, bool animations)
+{
+    if (running) {
+        stop();
+    }
+
+    records = trace;
+    position = 0;
+    failed = 0;
+    speed = replaySpeed;
+    currentStructure = -1;
+    running = true;
+
+    arrayAnimations = arrayWidget->animationsEnabled();
+    listAnimations = linkedListWidget->animationsEnabled();
+    unrolledAnimations = unrolledListWidget->animationsEnabled();
+    arrayWidget->setAnimationsEnabled(animations);
+    linkedListWidget->setAnimationsEnabled(animations);
+    unrolledListWidget->setAnimationsEnabled(animations);
+
+    clock.start();
+    timer->start(0);
+}
+
+void TraceReplayer::stop()
+{
+    if (running) {
+        finish();
+    }
+}
+
+void TraceReplayer::onTimeout()
+{
+    if (speed <= 0) {
+        // 不限速：连续执行一帧的时间，再让出事件循环以便重绘和响应停止
+        QElapsedTimer slice;
+        slice.start();
+        while (running && position < records.size() && slice.elapsed() < SLICE_MS) {
+            applyNext();
+        }
+    } else {
+        // 执行所有已到期的记录（同一时刻录制的批量操作一起执行）
+        qint64 now = clock.elapsed();
+        while (running && position < records.size() && dueTime(position) <= now) {
+            applyNext();
+        }
+    }
+
+    if (!running) {
+        return;  // 执行期间已被停止，finished 已经发出
+    }
+    if (position >= records.size()) {
+        finish();
+        return;
+    }
+
+    qint64 wait = speed <= 0 ? 0 : dueTime(position) - clock.elapsed();
+    timer->start(static_cast<int>(qMax<qint64>(0, wait)));
+}
+
+qint64 TraceReplayer::dueTime(int index) const
+{
+    return static_cast<qint64>((records[index].timeMs - records[0].timeMs) / speed);
+}
+
+void TraceReplayer::applyNext()
+{
+    // 切换结构时界面会处理事件（MainWindow::onTypeChanged 调用 processEvents），期间可能停止甚至重新开始回放，
+    // records 随之被清空或替换；所以切换后直接返回，由调用方重新检查 running 和 position 后再取记录
+    int structure = records[position].structure;
+    if (structure != currentStructure) {
+        currentStructure = structure;
+        emit structureChanged(structure);
+        return;
+    }
+
+    // 按值取出，执行期间 records 即使被修改也不影响这条记录
+    TraceRecord record = records[position];
+    if (!applyRecord(record)) {
+        ++failed;
+    }
+    ++position;
+}
+
+bool TraceReplayer::applyRecord(const TraceRecord &record)
+{
+    QString value = record.values.isEmpty() ? QString() : record.values.first();
+    if (record.structure == TraceRecord::Array || record.structure == TraceRecord::RingArray) {
+        arrayWidget->setRingMode(record.structure == TraceRecord::RingArray);
+        switch (record.type) {
+        case TraceRecord::Init:
+            arrayWidget->initialize(record.values);
+            return true;
+        case TraceRecord::Insert:
+            return arrayWidget->insertElement(record.index, value);
+        case TraceRecord::Delete:
+            return arrayWidget->deleteElement(record.index);
+        case TraceRecord::Modify:
+            return arrayWidget->modifyElement(record.index, value);
+        }
+    } else if (record.structure == TraceRecord::LinkedList) {
+        switch (record.type) {
+        case TraceRecord::Init:
+            linkedListWidget->initialize(record.values);
+            return true;
+        case TraceRecord::Insert:
+            return linkedListWidget->addElement(record.index, value);
+        case TraceRecord::Delete:
+            return linkedListWidget->deleteElement(record.index);
+        case TraceRecord::Modify:
+            return linkedListWidget->modifyElement(record.index, value);
+        }
+    } else {
+        switch (record.type) {
+        case TraceRecord::Init:
+            unrolledListWidget->initialize(record.values);
+            return true;
+        case TraceRecord::Insert:
+            return unrolledListWidget->addElement(record.index, value);
+        case TraceRecord::Delete:
+            return unrolledListWidget->deleteElement(record.index);
+        case TraceRecord::Modify:
+            return unrolledListWidget->modifyElement(record.index, value);
+        }
+    }
+    return false;
+}
+
+void TraceReplayer::finish()
+{
+    // 停止可能发生在执行记录时处理的事件中，返回 onTimeout 后不再重复结束
+    if (!running) {
+        return;
+    }
+
+    timer->stop();
+    running = false;
+    qint64 elapsed = clock.elapsed();
+
+    arrayWidget->setAnimationsEnabled(arrayAnimations);
+    linkedListWidget->setAnimationsEnabled(listAnimations);
+    unrolledListWidget->setAnimationsEnabled(unrolledAnimations);
+
+    int applied = position - failed;
+    records.clear();
+    emit finished(applied, failed, elapsed);
+}
@@ -0,0 +1,57 @@
+#ifndef TRACEREPLAYER_H
+#define TRACEREPLAYER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "OperationTrace.h"
+#include "ArrayWidget.h"
+#include "LinkedListWidget.h"
+#include "UnrolledListWidget.h"
+
+// 操作轨迹回放：按录制时的时间间隔（除以倍速）把记录依次交给数组/链表/展开链表组件执行
+// 倍速为 0 时不限速，每次连续执行约一帧的时间后让出事件循环，界面仍能刷新
+class TraceReplayer : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void structureChanged(int structure);  // 下一条记录作用于另一种结构时发出，参数为 TraceRecord::Structure
+    void finished(int applied, int failed, qint64 elapsedMs);
+
+public:
+    TraceReplayer(ArrayWidget *arrayWidget, LinkedListWidget *linkedListWidget,
+                  UnrolledListWidget *unrolledListWidget, QObject *parent = nullptr);
+
+    void start(const TraceRecordList &records, double speed, bool animations);
+    void stop();  // 提前结束，同样发出 finished（只发出一次）
+    bool isRunning() const { return running; }
+
+private slots:
+    void onTimeout();
+
+private:
+    void applyNext();  // 执行第 position 条记录；需要先切换结构时只切换，不前进
+    bool applyRecord(const TraceRecord &record);  // 返回组件是否接受了该操作
+    qint64 dueTime(int position) const;  // 第 position 条记录相对回放开始的执行时刻
+    void finish();
+
+    ArrayWidget *arrayWidget;
+    LinkedListWidget *linkedListWidget;
+    UnrolledListWidget *unrolledListWidget;
+    TraceRecordList records;
+    int position;  // 下一条待执行的记录
+    int failed;
+    double speed;
+    bool running;
+    int currentStructure;
+    bool arrayAnimations;  // 回放前的动画开关，结束后恢复
+    bool listAnimations;
+    bool unrolledAnimations;
+    QElapsedTimer clock;
+    QTimer *timer;
+
+    static const int SLICE_MS = 16;  // 不限速时每次连续执行的时长
+};
+
+#endif // TRACEREPLAYER_H
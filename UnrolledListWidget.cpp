@@ -0,0 +1,834 @@
+#include "UnrolledListWidget.h"
+#include "LinearPainter.h"
+#include <QPainter>
+#include <QTimer>
+#include <QMouseEvent>
+#include <QCoreApplication>
+#include <algorithm>
+
+namespace {
+
+// 按值传参，避免 qBound 以引用方式使用类内静态常量
+int boundedInt(int low, int value, int high)
+{
+    return value < low ? low : (value > high ? high : value);
+}
+
+}
+
+UnrolledListWidget::UnrolledListWidget(QWidget *parent)
+    : QWidget(parent)
+    , cellWidth(40)
+    , cellHeight(45)
+    , nodeWidth(0)
+    , nodeHeight(0)
+    , arrowLength(40)
+    , spacing(10)
+    , nodesPerRow(1)
+    , totalRows(1)
+    , startX(0)
+    , startY(0)
+    , contentHeight(0)
+    , layoutReady(false)
+    , layoutKeyCount(-1)
+    , layoutKeyWidth(0)
+    , layoutKeyHeight(0)
+    , backgroundValid(false)
+{
+    setMinimumHeight(200);
+    nodeWidth = UnrolledNode::CAPACITY * cellWidth + 2 * NODE_PADDING;
+    nodeHeight = cellHeight + 2 * NODE_PADDING;
+
+    // 节点过多时通过滚动条浏览，只绘制可视区域内的节点
+    vScrollBar = new QScrollBar(Qt::Vertical, this);
+    vScrollBar->setRange(0, 0);
+    vScrollBar->hide();
+    connect(vScrollBar, SIGNAL(valueChanged(int)), this, SLOT(onScrollValueChanged()));
+
+    // 两条时间线共用一个帧定时器，都没有活跃效果时停止
+    frameTimer = new QTimer(this);
+    frameTimer->setInterval(FRAME_INTERVAL_MS);
+    connect(frameTimer, SIGNAL(timeout()), this, SLOT(onAnimationFrame()));
+
+    updateTextLayout();
+}
+
+UnrolledListWidget::~UnrolledListWidget()
+{
+}
+
+void UnrolledListWidget::initialize(int size)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 停止所有动画
+    timeline.clear();
+    nodeTimeline.clear();
+    frameTimer->stop();
+
+    model.reset(size);
+
+    updateLayout();
+    update();
+}
+
+void UnrolledListWidget::initialize(const QStringList &values)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 停止所有动画
+    timeline.clear();
+    nodeTimeline.clear();
+    frameTimer->stop();
+
+    model.reset(values);
+
+    updateLayout();
+    update();
+}
+
+bool UnrolledListWidget::addElement(int index, const QString &value)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int insertIndex = model.insertAfter(index, value);
+    if (insertIndex < 0) {
+        return false;
+    }
+
+    // 后续元素索引加一；节点拆分时后续节点序号也加一
+    timeline.shiftIndices(insertIndex, 1);
+    trackNodeChange();
+    updateLayout();
+    update();
+
+    startEffect(insertIndex, INSERT_HIGHLIGHT_MS, true);
+    return true;
+}
+
+bool UnrolledListWidget::deleteElement(int index)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 立即删除，同一节点内的后续元素补位并弹起提示删除位置
+    if (!model.removeAt(index)) {
+        return false;
+    }
+
+    timeline.remove(index);
+    timeline.shiftIndices(index + 1, -1);
+    trackNodeChange();
+    updateLayout();
+    update();
+
+    if (index < model.size()) {
+        startEffect(index, 0, true);
+    } else {
+        startFrameTimer();
+    }
+    return true;
+}
+
+bool UnrolledListWidget::modifyElement(int index, const QString &value)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    if (!model.modify(index, value)) {
+        return false;
+    }
+
+    startEffect(index, EDIT_HIGHLIGHT_MS, true);
+    return true;
+}
+
+int UnrolledListWidget::applyBatch(const LinearOpList &ops)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int applied = 0;
+    int focusIndex = -1;
+
+    for (const LinearOp &op : ops) {
+        if (op.type == LinearOp::Insert) {
+            int insertIndex = model.insertAfter(op.index, op.value);
+            if (insertIndex < 0) {
+                continue;
+            }
+            timeline.shiftIndices(insertIndex, 1);
+            timeline.start(insertIndex, INSERT_HIGHLIGHT_MS, false);
+            focusIndex = insertIndex;
+        } else if (op.type == LinearOp::Delete) {
+            if (!model.removeAt(op.index)) {
+                continue;
+            }
+            timeline.remove(op.index);
+            timeline.shiftIndices(op.index + 1, -1);
+            focusIndex = qMin(op.index, model.size() - 1);
+        } else {
+            if (!model.modify(op.index, op.value)) {
+                continue;
+            }
+            timeline.start(op.index, EDIT_HIGHLIGHT_MS, false);
+            focusIndex = op.index;
+        }
+        // 每个操作之后立即修正节点序号，后续操作的拆分/合并才能对应到正确的节点
+        trackNodeChange();
+        ++applied;
+    }
+
+    if (applied > 0) {
+        finishBatch(focusIndex);
+    }
+    return applied;
+}
+
+int UnrolledListWidget::insertRange(int index, const QStringList &values)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 逐个插入而不是调用 model.insertRange()，每一次拆分都要记到节点时间线上
+    int insertIndex = index < 0 ? 0 : qMin(index + 1, model.size());
+    int inserted = 0;
+    int at = index;
+    for (const QString &value : values) {
+        at = model.insertAfter(at, value);
+        if (at < 0) {
+            break;  // 达到元素数量上限
+        }
+        trackNodeChange();
+        ++inserted;
+    }
+
+    timeline.shiftIndices(insertIndex, inserted);
+    for (int k = 0; k < inserted; ++k) {
+        timeline.start(insertIndex + k, INSERT_HIGHLIGHT_MS, false);
+    }
+
+    if (inserted > 0) {
+        finishBatch(insertIndex);
+    }
+    return inserted;
+}
+
+int UnrolledListWidget::deleteRange(int index, int count)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    int removed = 0;
+    while (removed < count && model.removeAt(index)) {
+        trackNodeChange();
+        ++removed;
+    }
+
+    if (removed > 0) {
+        for (int k = 0; k < removed; ++k) {
+            timeline.remove(index + k);
+        }
+        timeline.shiftIndices(index + removed, -removed);
+        finishBatch(qMin(index, model.size() - 1));
+    }
+    return removed;
+}
+
+int UnrolledListWidget::appendValues(const QStringList &values)
+{
+    OpCostScope costScope(model.cost(), lastOperationCost, totalOperationCost);
+    // 追加到末尾时末尾节点满了就新建节点，不会拆分，也不需要提示
+    int appended = model.insertRange(model.size() - 1, values);
+    if (appended > 0) {
+        updateLayout();
+        update();
+    }
+    return appended;
+}
+
+void UnrolledListWidget::finishBatch(int focusIndex)
+{
+    // 整批操作只布局一次，受影响的元素一起高亮，只有最后一个弹起
+    updateLayout();
+    update();
+
+    if (focusIndex >= 0) {
+        startEffect(focusIndex, 0, true);
+    } else {
+        startFrameTimer();
+    }
+}
+
+void UnrolledListWidget::trackNodeChange()
+{
+    UnrolledChange change = model.lastChange();
+    switch (change.kind) {
+    case UnrolledChange::Split:
+        // 新节点插在 node 之后，原来的后续节点序号加一，拆出的两个节点一起提示
+        nodeTimeline.shiftIndices(change.node + 1, 1);
+        nodeTimeline.start(change.node, STRUCTURE_HIGHLIGHT_MS, false, change.kind);
+        nodeTimeline.start(change.node + 1, STRUCTURE_HIGHLIGHT_MS, false, change.kind);
+        break;
+    case UnrolledChange::Merge:
+        // node+1 并入 node 后被删除
+        nodeTimeline.remove(change.node + 1);
+        nodeTimeline.shiftIndices(change.node + 2, -1);
+        nodeTimeline.start(change.node, STRUCTURE_HIGHLIGHT_MS, false, change.kind);
+        break;
+    case UnrolledChange::Borrow:
+        nodeTimeline.start(change.node, STRUCTURE_HIGHLIGHT_MS, false, change.kind);
+        nodeTimeline.start(change.node + 1, STRUCTURE_HIGHLIGHT_MS, false, change.kind);
+        break;
+    case UnrolledChange::Remove:
+        nodeTimeline.remove(change.node);
+        break;
+    default:
+        break;
+    }
+}
+
+void UnrolledListWidget::startEffect(int index, int highlightMs, bool bounce)
+{
+    if (bounce) {
+        ensureIndexVisible(index);
+    }
+    timeline.start(index, highlightMs, bounce);
+    markElementDirty(index);
+    startFrameTimer();
+}
+
+void UnrolledListWidget::startFrameTimer()
+{
+    // 动画关闭时时间线保持为空，不需要启动帧定时器
+    if ((!timeline.isEmpty() || !nodeTimeline.isEmpty()) && !frameTimer->isActive()) {
+        frameTimer->start();
+    }
+}
+
+void UnrolledListWidget::setAnimationsEnabled(bool enabled)
+{
+    timeline.setEnabled(enabled);
+    nodeTimeline.setEnabled(enabled);
+    if (!enabled) {
+        frameTimer->stop();
+        invalidateBackground();
+        update();
+    }
+}
+
+void UnrolledListWidget::onAnimationFrame()
+{
+    hud.markAnimationFrame();
+
+    // 弹起或高亮刚结束的格子重绘为静止状态，仍在弹起的格子只重绘其所在区域
+    QVector<int> settled = timeline.advance();
+    for (int index : settled) {
+        markElementDirty(index);
+    }
+    QVector<int> bouncing = timeline.bouncingIndices();
+    for (int index : bouncing) {
+        update(elementDirtyRect(index));
+    }
+    // 拆分/合并提示结束的节点恢复普通边框
+    QVector<int> settledNodes = nodeTimeline.advance();
+    for (int nodeIndex : settledNodes) {
+        markNodeDirty(nodeIndex);
+    }
+    if (hud.isEnabled()) {
+        update(hud.overlayRect(rect()));
+    }
+
+    if (timeline.isEmpty() && nodeTimeline.isEmpty()) {
+        frameTimer->stop();
+    }
+}
+
+void UnrolledListWidget::resetCostCounters()
+{
+    lastOperationCost = OpCost();
+    totalOperationCost = OpCost();
+}
+
+void UnrolledListWidget::freezeAnimationClock(qint64 offsetMs)
+{
+    timeline.freezeClock(offsetMs);
+    nodeTimeline.freezeClock(offsetMs);
+}
+
+void UnrolledListWidget::setHudVisible(bool visible)
+{
+    hud.setEnabled(visible);
+    update();
+}
+
+void UnrolledListWidget::updateLayout()
+{
+    PerfHud::Scope layoutScope(hud, PerfHud::LayoutMetric);
+    invalidateBackground();
+
+    int nodes = model.nodeCount();
+    if (nodes <= 0) {
+        contentHeight = 0;
+        layoutKeyCount = -1;
+        updateScrollBar();
+        return;
+    }
+
+    // 如果组件还没有正确的尺寸，延迟更新
+    if (width() <= 0 || height() <= 0) {
+        return;
+    }
+
+    // 节点数量和组件尺寸都没变时沿用上次的求解结果（节点内增删元素不影响布局）
+    if (nodes == layoutKeyCount && width() == layoutKeyWidth && height() == layoutKeyHeight) {
+        layoutReady = true;
+        return;
+    }
+
+    int availableWidth = width() - 2 * HORIZONTAL_MARGIN;
+    int availableHeight = height() - 2 * VERTICAL_MARGIN;
+
+    // 与链表相同的直接求解，只是节点宽度由格子宽度决定：
+    // 由可用高度得到最多能放的行数，由行数得到每行至少需要的节点数，再得到能放下的最大格子宽度
+    int maxRows = qMax(1, (availableHeight + ROW_SPACING) / (MIN_CELL_HEIGHT + 2 * NODE_PADDING + ROW_SPACING));
+    int neededCols = (nodes + maxRows - 1) / maxRows;
+    int fitNodeWidth = (availableWidth + MIN_SPACING) / neededCols - MIN_SPACING - MIN_ARROW_LENGTH;
+    int fitCellWidth = (fitNodeWidth - 2 * NODE_PADDING) / UnrolledNode::CAPACITY;
+
+    arrowLength = MIN_ARROW_LENGTH;
+    spacing = MIN_SPACING;
+    if (fitCellWidth < MIN_CELL_WIDTH) {
+        // 最小尺寸也放不下：使用最小尺寸并启用滚动（为滚动条让出宽度）
+        availableWidth -= vScrollBar->sizeHint().width();
+        cellWidth = MIN_CELL_WIDTH;
+        cellHeight = MIN_CELL_HEIGHT;
+        nodeWidth = UnrolledNode::CAPACITY * cellWidth + 2 * NODE_PADDING;
+        nodesPerRow = qMax(1, (availableWidth + spacing) / (nodeWidth + arrowLength + spacing));
+        totalRows = (nodes + nodesPerRow - 1) / nodesPerRow;
+    } else {
+        cellWidth = boundedInt(MIN_CELL_WIDTH, fitCellWidth, MAX_CELL_WIDTH);
+        nodeWidth = UnrolledNode::CAPACITY * cellWidth + 2 * NODE_PADDING;
+        nodesPerRow = qMax(1, (availableWidth + spacing) / (nodeWidth + arrowLength + spacing));
+        totalRows = (nodes + nodesPerRow - 1) / nodesPerRow;
+        cellHeight = boundedInt(MIN_CELL_HEIGHT,
+                                (availableHeight - (totalRows - 1) * ROW_SPACING) / totalRows - 2 * NODE_PADDING,
+                                MAX_CELL_HEIGHT);
+
+        // 剩余宽度平均分给每个节点后面的箭头
+        int usedWidth = nodesPerRow * (nodeWidth + arrowLength + spacing) - spacing;
+        arrowLength = boundedInt(MIN_ARROW_LENGTH, arrowLength + (availableWidth - usedWidth) / nodesPerRow,
+                                 MAX_ARROW_LENGTH);
+    }
+    nodeHeight = cellHeight + 2 * NODE_PADDING;
+
+    int nodeUnitWidth = nodeWidth + arrowLength + spacing;
+    int totalNodeWidth = nodesPerRow * nodeUnitWidth - spacing;
+    int totalNodeHeight = totalRows * nodeHeight + (totalRows - 1) * ROW_SPACING;
+
+    // 第一行上方留出节点标签的空间
+    startX = HORIZONTAL_MARGIN + qMax(0, (availableWidth - totalNodeWidth) / 2);
+    startY = VERTICAL_MARGIN + LABEL_HEIGHT;
+    contentHeight = startY + totalNodeHeight + VERTICAL_MARGIN;
+
+    layoutKeyCount = nodes;
+    layoutKeyWidth = width();
+    layoutKeyHeight = height();
+    layoutReady = true;
+    updateTextLayout();
+    updateScrollBar();
+}
+
+void UnrolledListWidget::ensureLayout()
+{
+    if (!layoutReady) {
+        updateLayout();
+    }
+}
+
+void UnrolledListWidget::updateTextLayout()
+{
+    // 字体只随格子大小变化，整个组件共用；尺寸不变时缓存保持有效
+    valueTexts.setFont(QFont("Arial", qMax(7, qMin(11, cellWidth / 5)), QFont::Bold));
+    valueTexts.setMaxWidth(cellWidth - 2 * TEXT_PADDING);
+    labelTexts.setFont(QFont("Arial", 8));
+    labelTexts.setMaxWidth(nodeWidth);
+}
+
+void UnrolledListWidget::updateScrollBar()
+{
+    int overflow = contentHeight - height();
+    if (overflow > 0) {
+        int barWidth = vScrollBar->sizeHint().width();
+        vScrollBar->setGeometry(width() - barWidth, 0, barWidth, height());
+        vScrollBar->setRange(0, overflow);
+        vScrollBar->setPageStep(height());
+        vScrollBar->setSingleStep(nodeHeight + ROW_SPACING);
+        vScrollBar->show();
+    } else {
+        vScrollBar->setRange(0, 0);
+        vScrollBar->hide();
+    }
+}
+
+QPointF UnrolledListWidget::nodePosition(int nodeIndex) const
+{
+    int row = nodeIndex / nodesPerRow;
+    int col = nodeIndex % nodesPerRow;
+
+    int x = startX + col * (nodeWidth + arrowLength + spacing);
+    int y = startY + row * (nodeHeight + ROW_SPACING) - vScrollBar->value();
+    return QPointF(x, y);
+}
+
+QRectF UnrolledListWidget::cellRect(int nodeIndex, int slot) const
+{
+    // 相邻格子左右各留 1 像素，边框不会重叠
+    QPointF pos = nodePosition(nodeIndex);
+    return QRectF(pos.x() + NODE_PADDING + slot * cellWidth + 1, pos.y() + NODE_PADDING,
+                  cellWidth - 2, cellHeight);
+}
+
+int UnrolledListWidget::elementIndexAt(const QPointF &pos)
+{
+    if (model.nodeCount() <= 0) {
+        return -1;
+    }
+
+    // 节点网格是均匀的：先求出行列得到节点，再由节点内的横坐标直接求出格子
+    int columnPitch = nodeWidth + arrowLength + spacing;
+    int rowPitch = nodeHeight + ROW_SPACING;
+    qreal x = pos.x() - startX;
+    qreal y = pos.y() + vScrollBar->value() - startY;
+    if (x < 0 || y < 0) {
+        return -1;
+    }
+
+    int col = int(x) / columnPitch;
+    int row = int(y) / rowPitch;
+    if (col >= nodesPerRow) {
+        return -1;
+    }
+    qreal cellX = x - col * columnPitch - NODE_PADDING;
+    qreal cellY = y - row * rowPitch - NODE_PADDING;
+    if (cellX < 0 || cellY < 0 || cellY > cellHeight) {
+        return -1;
+    }
+    int slot = int(cellX) / cellWidth;
+    if (slot >= UnrolledNode::CAPACITY) {
+        return -1;
+    }
+
+    int firstIndex = 0;
+    UnrolledNode *node = model.nodeAt(row * nodesPerRow + col, firstIndex);
+    if (!node || slot >= node->count) {
+        return -1;  // 空闲槽位不对应任何元素
+    }
+    return firstIndex + slot;
+}
+
+void UnrolledListWidget::visibleRange(int &firstNode, int &lastNode) const
+{
+    // 每行在内容坐标中占据 [行顶 - 标签高度, 行底 + 行间箭头]
+    int rowPitch = nodeHeight + ROW_SPACING;
+    int viewTop = vScrollBar->value();
+    int viewBottom = viewTop + height();
+
+    int firstRow = qMax(0, (viewTop - startY - rowPitch) / rowPitch);
+    int lastRow = qMax(0, (viewBottom - startY + LABEL_HEIGHT) / rowPitch);
+
+    firstNode = qMin(model.nodeCount(), firstRow * nodesPerRow);
+    lastNode = qMin(model.nodeCount(), (lastRow + 1) * nodesPerRow);
+}
+
+void UnrolledListWidget::ensureIndexVisible(int index)
+{
+    ensureLayout();
+    int nodeIndex = 0;
+    int slot = 0;
+    if (vScrollBar->maximum() <= 0 || !model.locate(index, nodeIndex, slot)) {
+        return;
+    }
+
+    int rowTop = startY + (nodeIndex / nodesPerRow) * (nodeHeight + ROW_SPACING) - LABEL_HEIGHT;
+    int rowBottom = rowTop + LABEL_HEIGHT + nodeHeight;
+    int viewTop = vScrollBar->value();
+
+    if (rowTop < viewTop) {
+        vScrollBar->setValue(rowTop - VERTICAL_MARGIN);
+    } else if (rowBottom > viewTop + height()) {
+        vScrollBar->setValue(rowBottom - height() + VERTICAL_MARGIN);
+    }
+}
+
+void UnrolledListWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    // 拖动窗口时会连续收到多次 resizeEvent，这里只标记布局失效，
+    // 由下一次 paintEvent 统一计算，每帧最多求解一次
+    layoutReady = false;
+    update();
+}
+
+void UnrolledListWidget::wheelEvent(QWheelEvent *event)
+{
+    // 滚轮事件交给滚动条处理
+    if (vScrollBar->maximum() > 0) {
+        QCoreApplication::sendEvent(vScrollBar, event);
+        return;
+    }
+    QWidget::wheelEvent(event);
+}
+
+void UnrolledListWidget::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    if (hud.isEnabled()) {
+        qint64 dirtyPixels = 0;
+        for (const QRect &r : event->region()) {
+            dirtyPixels += qint64(r.width()) * r.height();
+        }
+        hud.setRepaintArea(dirtyPixels, qint64(width()) * height());
+    }
+
+    {
+        PerfHud::Scope paintScope(hud, PerfHud::PaintMetric);
+        paintContent(painter);
+    }
+
+    // 性能面板不计入绘制耗时
+    if (hud.isEnabled()) {
+        hud.paint(painter, rect());
+    }
+}
+
+void UnrolledListWidget::paintContent(QPainter &painter)
+{
+    if (model.nodeCount() <= 0) {
+        painter.fillRect(rect(), QColor(240, 240, 240));
+        return;
+    }
+
+    // 确保布局已更新
+    ensureLayout();
+
+    // 静态内容（背景、箭头、节点和非弹起格子）缓存在图层中，
+    // 动画过程中每帧只需贴图一次并重绘正在弹起的格子
+    QVector<int> bouncing = timeline.bouncingIndices();
+    std::sort(bouncing.begin(), bouncing.end());
+    qreal ratio = devicePixelRatioF();
+    QSize cacheSize = size() * ratio;
+    if (!backgroundValid || backgroundCache.size() != cacheSize) {
+        backgroundCache = QPixmap(cacheSize);
+        backgroundCache.setDevicePixelRatio(ratio);
+        QPainter cachePainter(&backgroundCache);
+        renderBackground(cachePainter);
+        backgroundSkipped = bouncing;
+        backgroundValid = true;
+        backgroundDirty = QRegion();
+    } else {
+        // 开始或结束弹起的格子所在区域需要重新生成（屏幕上的重绘已由动画帧安排）
+        if (backgroundSkipped != bouncing) {
+            for (int index : backgroundSkipped) {
+                backgroundDirty += elementDirtyRect(index);
+            }
+            for (int index : bouncing) {
+                backgroundDirty += elementDirtyRect(index);
+            }
+            backgroundSkipped = bouncing;
+        }
+        // 只重绘图层中的脏区域
+        if (!backgroundDirty.isEmpty()) {
+            QPainter cachePainter(&backgroundCache);
+            cachePainter.setClipRegion(backgroundDirty);
+            renderBackground(cachePainter);
+            backgroundDirty = QRegion();
+        }
+    }
+    painter.drawPixmap(0, 0, backgroundCache);
+
+    if (!bouncing.isEmpty()) {
+        painter.setRenderHint(QPainter::Antialiasing);
+    }
+    for (int index : bouncing) {
+        int nodeIndex = 0;
+        int slot = 0;
+        UnrolledNode *node = model.locate(index, nodeIndex, slot);
+        if (!node) {
+            continue;
+        }
+
+        // 计算动画位置
+        QRectF rect = cellRect(nodeIndex, slot);
+        rect.translate(0, -BOUNCE_HEIGHT * timeline.bounceHeight(index));
+        paintCell(painter, node, slot, index, rect);
+    }
+}
+
+void UnrolledListWidget::renderBackground(QPainter &painter)
+{
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // 绘制背景
+    painter.fillRect(rect(), QColor(240, 240, 240));
+
+    // 只绘制与可视区域相交的节点
+    int firstNode = 0;
+    int lastNode = 0;
+    visibleRange(firstNode, lastNode);
+    int firstIndex = 0;
+    UnrolledNode *firstVisible = model.nodeAt(firstNode, firstIndex);
+
+    // 先绘制节点之间的箭头（在节点下方，避免被节点遮挡）
+    UnrolledNode *current = firstVisible;
+    for (int nodeIndex = firstNode; current && current->next && nodeIndex < lastNode; ++nodeIndex) {
+        QPointF pos = nodePosition(nodeIndex);
+        int nextIndex = nodeIndex + 1;
+        if (nextIndex / nodesPerRow == nodeIndex / nodesPerRow) {
+            // 下一个节点在同一行，绘制水平箭头
+            QPointF arrowStart(pos.x() + nodeWidth, pos.y() + nodeHeight / 2);
+            LinearPainter::drawArrow(painter, arrowStart, QPointF(arrowStart.x() + arrowLength, arrowStart.y()));
+        } else {
+            // 下一个节点在下一行开头，从节点底部画到下一行上方
+            QPointF arrowStart(pos.x() + nodeWidth / 2, pos.y() + nodeHeight);
+            LinearPainter::drawArrow(painter, arrowStart, QPointF(arrowStart.x(), arrowStart.y() + ROW_SPACING));
+        }
+        current = current->next;
+    }
+
+    // 再绘制节点和其中的格子
+    int drawn = 0;
+    current = firstVisible;
+    int first = firstIndex;
+    for (int nodeIndex = firstNode; current && nodeIndex < lastNode; ++nodeIndex) {
+        paintNode(painter, current, nodeIndex, first);
+        drawn += current->count;
+        first += current->count;
+        current = current->next;
+    }
+
+    if (hud.isEnabled()) {
+        hud.setElementCounts(drawn, model.size() - drawn);
+        hud.setValuePoolStats(ValuePool::shared().stats());
+    }
+}
+
+void UnrolledListWidget::paintNode(QPainter &painter, const UnrolledNode *node, int nodeIndex, int firstIndex)
+{
+    // 节点外框：拆分/合并提示期间用橙色边框
+    QPointF pos = nodePosition(nodeIndex);
+    QRectF nodeRect(pos.x(), pos.y(), nodeWidth, nodeHeight);
+    bool changed = nodeTimeline.isHighlighted(nodeIndex);
+    painter.setPen(QPen(changed ? QColor(255, 140, 0) : QColor(150, 150, 150), 2));
+    painter.setBrush(QColor(250, 250, 250));
+    painter.drawRoundedRect(nodeRect, 6, 6);
+
+    // 已用槽位按数组元素的样式绘制，空闲槽位画成空格子
+    for (int slot = 0; slot < UnrolledNode::CAPACITY; ++slot) {
+        QRectF rect = cellRect(nodeIndex, slot);
+        if (slot >= node->count) {
+            LinearPainter::drawCell(painter, rect, LinearPainter::EmptyCell);
+        } else if (!timeline.isBouncing(firstIndex + slot)) {
+            paintCell(painter, node, slot, firstIndex + slot, rect);
+        }
+    }
+
+    // 节点上方标注包含的索引范围和已用槽位数，提示期间附上变化类型
+    QString label = node->count > 1 ? QString("[%1-%2]").arg(firstIndex).arg(firstIndex + node->count - 1)
+                                    : QString("[%1]").arg(firstIndex);
+    label += QString(" %1/%2").arg(node->count).arg(int(UnrolledNode::CAPACITY));
+    if (changed) {
+        // 每个节点显示自己参与的那次变化，不受之后其他节点变化的影响
+        int kind = nodeTimeline.tag(nodeIndex);
+        if (kind == UnrolledChange::Split) {
+            label += QStringLiteral(" 拆分");
+        } else if (kind == UnrolledChange::Merge) {
+            label += QStringLiteral(" 合并");
+        } else if (kind == UnrolledChange::Borrow) {
+            label += QStringLiteral(" 借位");
+        }
+    }
+    painter.setPen(changed ? QColor(200, 100, 0) : QColor(100, 100, 100));
+    labelTexts.draw(painter, QRectF(pos.x(), pos.y() - LABEL_HEIGHT, nodeWidth, 15), label);
+}
+
+void UnrolledListWidget::paintCell(QPainter &painter, const UnrolledNode *node, int slot, int index,
+                                   const QRectF &rect)
+{
+    LinearPainter::drawCell(painter, rect, timeline.isHighlighted(index) ? LinearPainter::HighlightedCell
+                                                                         : LinearPainter::NormalCell);
+
+    // 绘制值（字体和排版结果由缓存提供，过长的值以省略号结尾）
+    painter.setPen(QColor(0, 0, 0));
+    valueTexts.draw(painter, rect, model.valueOf(node, slot));
+}
+
+void UnrolledListWidget::invalidateBackground()
+{
+    backgroundValid = false;
+}
+
+QRect UnrolledListWidget::nodeDirtyRect(int nodeIndex) const
+{
+    // 覆盖节点本身、上方的标签和格子弹起的偏移，左右各扩展一个箭头长度、下方扩展一个行间距以包含相邻箭头
+    QPointF pos = nodePosition(nodeIndex);
+    QRectF area(pos.x(), pos.y() - LABEL_HEIGHT - BOUNCE_HEIGHT,
+                nodeWidth, nodeHeight + LABEL_HEIGHT + BOUNCE_HEIGHT);
+    return area.adjusted(-arrowLength - 2, -2, arrowLength + 2, ROW_SPACING + 2).toAlignedRect();
+}
+
+QRect UnrolledListWidget::cellDirtyRect(int nodeIndex, int slot) const
+{
+    // 覆盖格子本身和弹起动画的偏移，外扩边框画笔宽度
+    QRectF area = cellRect(nodeIndex, slot);
+    area.setTop(area.top() - BOUNCE_HEIGHT);
+    return area.adjusted(-2, -2, 2, 2).toAlignedRect();
+}
+
+QRect UnrolledListWidget::elementDirtyRect(int index)
+{
+    int nodeIndex = 0;
+    int slot = 0;
+    if (!model.locate(index, nodeIndex, slot)) {
+        return QRect();
+    }
+    return cellDirtyRect(nodeIndex, slot);
+}
+
+void UnrolledListWidget::markNodeDirty(int nodeIndex)
+{
+    // 不可见的节点不在图层中，滚动到它时会整体重绘
+    int firstNode = 0;
+    int lastNode = 0;
+    visibleRange(firstNode, lastNode);
+    if (nodeIndex < firstNode || nodeIndex >= lastNode) {
+        return;
+    }
+    QRect dirty = nodeDirtyRect(nodeIndex);
+    backgroundDirty += dirty;
+    update(dirty);
+}
+
+void UnrolledListWidget::markElementDirty(int index)
+{
+    int nodeIndex = 0;
+    int slot = 0;
+    if (!model.locate(index, nodeIndex, slot)) {
+        return;
+    }
+    int firstNode = 0;
+    int lastNode = 0;
+    visibleRange(firstNode, lastNode);
+    if (nodeIndex < firstNode || nodeIndex >= lastNode) {
+        return;
+    }
+    QRect dirty = cellDirtyRect(nodeIndex, slot);
+    backgroundDirty += dirty;
+    update(dirty);
+}
+
+void UnrolledListWidget::onScrollValueChanged()
+{
+    invalidateBackground();
+    update();
+}
+
+void UnrolledListWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        ensureLayout();
+        int index = elementIndexAt(event->pos());
+        if (index >= 0) {
+            emit elementClicked(index);
+            return;
+        }
+    }
+    QWidget::mousePressEvent(event);
+}
@@ -0,0 +1,155 @@
+#ifndef UNROLLEDLISTWIDGET_H
+#define UNROLLEDLISTWIDGET_H
+
+#include <QWidget>
+#include <QPainter>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QScrollBar>
+#include <QPixmap>
+#include <QRegion>
+#include <QTimer>
+#include "UnrolledListModel.h"
+#include "AnimationTimeline.h"
+#include "LinearOp.h"
+#include "PerfHud.h"
+#include "TextLayoutCache.h"
+
+// 展开链表：节点按链表的方式用箭头相连，节点内部按数组的方式画出 CAPACITY 个格子
+// 元素的高亮和弹起按元素索引保存，节点拆分与合并的提示按节点序号另存一条时间线
+class UnrolledListWidget : public QWidget
+{
+    Q_OBJECT
+
+signals:
+    void elementClicked(int index);
+
+public:
+    explicit UnrolledListWidget(QWidget *parent = nullptr);
+    ~UnrolledListWidget();
+
+    static const int DEFAULT_MAX_ELEMENTS = UnrolledListModel::DEFAULT_MAX_ELEMENTS;  // 默认元素上限
+
+    void initialize(int size);
+    void initialize(const QStringList &values);
+    bool addElement(int index, const QString &value);  // 索引含义与链表相同：-1 表示开头
+    bool deleteElement(int index);
+    bool modifyElement(int index, const QString &value);
+
+    // 批量操作：先全部修改模型，再统一布局一次、播放一次高亮动画，返回成功的操作数
+    int applyBatch(const LinearOpList &ops);
+    int insertRange(int index, const QStringList &values);
+    int deleteRange(int index, int count);
+    int appendValues(const QStringList &values);  // 分块加载时在末尾追加，不播放动画，返回追加个数
+    int getSize() const { return model.size(); }
+    int nodeCount() const { return model.nodeCount(); }
+    QStringList getValues() const { return model.values(); }
+    QString getValue(int index) { return model.value(index); }
+    void setMaxElements(int limit) { model.setMaxElements(limit); }  // 设置元素数量上限
+    int maxElements() const { return model.maxElements(); }
+    NodePoolStats poolStats() const { return model.poolStats(); }
+    void setHudVisible(bool visible);  // 显示/隐藏性能统计面板
+    void setAnimationsEnabled(bool enabled);  // 关闭后操作立即生效，不播放高亮、弹起和拆分/合并提示
+    bool animationsEnabled() const { return timeline.isEnabled(); }
+    bool isHudVisible() const { return hud.isEnabled(); }
+    // 开销计数：最近一次操作（批量操作算一次）和自上次清零以来的累计，只统计经由本组件接口的操作
+    OpCost lastCost() const { return lastOperationCost; }
+    OpCost totalCost() const { return totalOperationCost; }
+    void resetCostCounters();
+    void freezeAnimationClock(qint64 offsetMs);  // 定格动画进度，见 AnimationTimeline::freezeClock（离屏渲染基准用）
+    void invalidateBackground();  // 结构、尺寸或滚动变化后调用；离屏渲染基准每帧调用以测量完整的一帧
+
+private slots:
+    void onScrollValueChanged();
+    void onAnimationFrame();  // 帧定时器回调：推进两条时间线并重绘受影响的格子和节点
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+
+private:
+    void updateLayout();
+    void ensureLayout();  // 布局失效（如窗口缩放后）时立即求解
+    void paintContent(QPainter &painter);
+    void renderBackground(QPainter &painter);  // 绘制除正在弹起的格子以外的全部可见内容
+    void paintNode(QPainter &painter, const UnrolledNode *node, int nodeIndex, int firstIndex);
+    void paintCell(QPainter &painter, const UnrolledNode *node, int slot, int index, const QRectF &rect);
+    void updateTextLayout();  // 格子尺寸变化后更新共用字体
+    QRect nodeDirtyRect(int nodeIndex) const;  // 节点变化时需要重绘的区域，包括上方标签和相邻箭头
+    QRect cellDirtyRect(int nodeIndex, int slot) const;  // 单个格子及其弹起范围
+    QRect elementDirtyRect(int index);  // 按元素索引定位格子，不存在时返回空矩形
+    void markNodeDirty(int nodeIndex);
+    void markElementDirty(int index);  // 单个元素的高亮或值变化后调用，只重绘该格子
+    void updateScrollBar();
+    void trackNodeChange();  // 读取模型最近一次的拆分/合并，修正节点时间线并开始提示
+    void startEffect(int index, int highlightMs, bool bounce);  // 在时间线上为元素开始高亮/弹起效果
+    void startFrameTimer();  // 任一时间线非空时启动帧定时器
+    void finishBatch(int focusIndex);  // 批量操作后的布局和动画
+    void ensureIndexVisible(int index);
+    QPointF nodePosition(int nodeIndex) const;  // 根据网格参数计算节点位置（已扣除滚动偏移）
+    QRectF cellRect(int nodeIndex, int slot) const;
+    int elementIndexAt(const QPointF &pos);  // 组件坐标处的元素索引，不在任何已用格子上时返回 -1
+    void visibleRange(int &firstNode, int &lastNode) const;  // 可视区域内的节点范围 [first, last)
+
+    UnrolledListModel model;  // 数据模型，本组件只负责绘制和动画
+    AnimationTimeline timeline;  // 按元素索引的高亮和弹起效果
+    AnimationTimeline nodeTimeline;  // 按节点序号的拆分/合并提示，只有高亮，标记为该节点的变化类型
+    QTimer *frameTimer;
+
+    // 动态计算的尺寸
+    int cellWidth;
+    int cellHeight;
+    int nodeWidth;  // CAPACITY 个格子加两侧内边距
+    int nodeHeight;
+    int arrowLength;
+    int spacing;
+    int nodesPerRow;  // 每行节点数量
+    int totalRows;  // 总行数
+    int startX;  // 节点网格左上角（内容坐标）
+    int startY;
+    int contentHeight;  // 内容总高度，超出可视区域时启用滚动
+    bool layoutReady;
+    int layoutKeyCount;  // 上次求解时的节点数量和组件尺寸，用于复用结果
+    int layoutKeyWidth;
+    int layoutKeyHeight;
+    QScrollBar *vScrollBar;
+    PerfHud hud;
+    OpCost lastOperationCost;
+    OpCost totalOperationCost;
+
+    // 静态内容图层：结构、尺寸或滚动变化时整体重绘，单个格子或节点变化时只重绘脏区域
+    QPixmap backgroundCache;
+    bool backgroundValid;
+    QVector<int> backgroundSkipped;  // 图层中未绘制的（正在弹起的）元素，已排序
+    QRegion backgroundDirty;  // 图层中待重绘的区域
+
+    // 文本排版缓存（值、节点标签各用一种字体）
+    TextLayoutCache valueTexts;
+    TextLayoutCache labelTexts;
+
+    static const int MIN_CELL_WIDTH = 30;
+    static const int MAX_CELL_WIDTH = 60;
+    static const int MIN_CELL_HEIGHT = 36;
+    static const int MAX_CELL_HEIGHT = 60;
+    static const int NODE_PADDING = 5;  // 节点边框与格子之间的距离
+    static const int MIN_ARROW_LENGTH = 30;
+    static const int MAX_ARROW_LENGTH = 50;
+    static const int MIN_SPACING = 10;
+    static const int HORIZONTAL_MARGIN = 20;
+    static const int VERTICAL_MARGIN = 20;
+    static const int ROW_SPACING = 30;  // 行间距（包括节点标签空间）
+    static const int LABEL_HEIGHT = 18;  // 节点上方的索引范围标签
+    static const int BOUNCE_HEIGHT = 10;  // 动画时格子弹起的最大高度
+    static const int TEXT_PADDING = 3;  // 值文本与格子边框的最小距离
+    static const int INSERT_HIGHLIGHT_MS = 600;  // 插入后的高亮时长
+    static const int EDIT_HIGHLIGHT_MS = 500;  // 修改后的高亮时长
+    static const int STRUCTURE_HIGHLIGHT_MS = 900;  // 节点拆分/合并后的提示时长
+    static const int FRAME_INTERVAL_MS = 16;  // 动画帧间隔
+};
+
+#endif // UNROLLEDLISTWIDGET_H
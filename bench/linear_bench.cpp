@@ -0,0 +1,377 @@
+// 数据模型操作的微基准（Google Benchmark）
+// 规模 10 ~ 10^6，分别在开头、中间、末尾位置操作
+// 输出 JSON：linear_bench --benchmark_format=json 或 --benchmark_out=result.json
+
+#include <benchmark/benchmark.h>
+#include <QString>
+#include <QStringList>
+#include "ArrayModel.h"
+#include "LinkedListModel.h"
+#include "UnrolledListModel.h"
+
+namespace {
+
+enum Position { Head = 0, Middle = 1, Tail = 2 };
+
+const char *positionName(int position)
+{
+    switch (position) {
+    case Head: return "head";
+    case Middle: return "middle";
+    default: return "tail";
+    }
+}
+
+QStringList makeValues(int count)
+{
+    QStringList values;
+    values.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        values << QString::number(i);
+    }
+    return values;
+}
+
+// 插入接口的“在索引之后插入”语义：-1 表示开头
+int insertIndexFor(int position, int size)
+{
+    switch (position) {
+    case Head: return -1;
+    case Middle: return size / 2;
+    default: return size;
+    }
+}
+
+int elementIndexFor(int position, int size)
+{
+    switch (position) {
+    case Head: return 0;
+    case Middle: return size / 2;
+    default: return size - 1;
+    }
+}
+
+// 插入/删除会改变规模，偏离初始规模这么多之后暂停计时并重新初始化
+int resetSlack(int size)
+{
+    return qMax(1, qMin(size / 2, 1024));
+}
+
+void sizesAndPositions(benchmark::internal::Benchmark *b)
+{
+    for (int size = 10; size <= 1000000; size *= 10) {
+        for (int position = Head; position <= Tail; ++position) {
+            b->Args({size, position});
+        }
+    }
+}
+
+void sizesOnly(benchmark::internal::Benchmark *b)
+{
+    for (int size = 10; size <= 1000000; size *= 10) {
+        b->Arg(size);
+    }
+}
+
+// ---------------- 数组 ----------------
+
+void BM_ArrayInsert(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QStringList values = makeValues(size);
+    const QString value("x");
+    
+    ArrayModel model;
+    model.reset(values);
+    for (auto _ : state) {
+        if (model.size() >= size + resetSlack(size)) {
+            state.PauseTiming();
+            model.reset(values);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(model.insert(insertIndexFor(position, model.size()), value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 数组删除只清空位置，随后立即填回（填充空位置是 O(1)），两者一起计时
+void BM_ArrayDeleteRefill(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QString value("x");
+    
+    ArrayModel model;
+    model.reset(makeValues(size));
+    const int index = elementIndexFor(position, size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.erase(index));
+        benchmark::DoNotOptimize(model.insert(index - 1, value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ArrayModify(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QString value("x");
+    
+    ArrayModel model;
+    model.reset(makeValues(size));
+    const int index = elementIndexFor(position, size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.modify(index, value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ArrayGetValues(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    
+    ArrayModel model;
+    model.reset(makeValues(size));
+    for (auto _ : state) {
+        QStringList result = model.values();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void BM_ArrayGetElementCount(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    
+    ArrayModel model;
+    model.reset(makeValues(size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.count());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// 环形缓冲区模式：两端插入不移动元素，与 BM_ArrayInsert 对比开头插入
+void BM_RingArrayInsert(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QStringList values = makeValues(size);
+    const QString value("x");
+    
+    ArrayModel model;
+    model.setRingMode(true);
+    model.reset(values);
+    for (auto _ : state) {
+        if (model.size() >= size + resetSlack(size)) {
+            state.PauseTiming();
+            model.reset(values);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(model.insert(insertIndexFor(position, model.size()), value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 两端出队（位置一起移除）后从同一端重新入队，一起计时；中间位置只清空，与普通数组相同
+void BM_RingArrayPopPush(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QString value("x");
+    
+    ArrayModel model;
+    model.setRingMode(true);
+    model.reset(makeValues(size));
+    for (auto _ : state) {
+        const int index = elementIndexFor(position, model.size());
+        benchmark::DoNotOptimize(model.erase(index));
+        benchmark::DoNotOptimize(model.insert(position == Tail ? model.size() : index - 1, value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ---------------- 链表 ----------------
+
+void BM_ListInsert(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QStringList values = makeValues(size);
+    const QString value("x");
+    
+    LinkedListModel model;
+    model.reset(values);
+    for (auto _ : state) {
+        if (model.size() >= size + resetSlack(size)) {
+            state.PauseTiming();
+            model.reset(values);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(model.insertAfter(insertIndexFor(position, model.size()), value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ListDelete(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QStringList values = makeValues(size);
+    
+    LinkedListModel model;
+    model.reset(values);
+    for (auto _ : state) {
+        if (model.size() <= size - resetSlack(size)) {
+            state.PauseTiming();
+            model.reset(values);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(model.removeAt(elementIndexFor(position, model.size())));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ListModify(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QString value("x");
+    
+    LinkedListModel model;
+    model.reset(makeValues(size));
+    const int index = elementIndexFor(position, size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.modify(index, value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ListGetValues(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    
+    LinkedListModel model;
+    model.reset(makeValues(size));
+    for (auto _ : state) {
+        QStringList result = model.values();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void BM_ListGetSize(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    
+    LinkedListModel model;
+    model.reset(makeValues(size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ---------------- 展开链表 ----------------
+
+void BM_UnrolledInsert(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QStringList values = makeValues(size);
+    const QString value("x");
+    
+    UnrolledListModel model;
+    model.reset(values);
+    for (auto _ : state) {
+        if (model.size() >= size + resetSlack(size)) {
+            state.PauseTiming();
+            model.reset(values);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(model.insertAfter(insertIndexFor(position, model.size()), value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_UnrolledDelete(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QStringList values = makeValues(size);
+    
+    UnrolledListModel model;
+    model.reset(values);
+    for (auto _ : state) {
+        if (model.size() <= size - resetSlack(size)) {
+            state.PauseTiming();
+            model.reset(values);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(model.removeAt(elementIndexFor(position, model.size())));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_UnrolledModify(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int position = static_cast<int>(state.range(1));
+    const QString value("x");
+    
+    UnrolledListModel model;
+    model.reset(makeValues(size));
+    const int index = elementIndexFor(position, size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.modify(index, value));
+    }
+    state.SetLabel(positionName(position));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_UnrolledGetValues(benchmark::State &state)
+{
+    const int size = static_cast<int>(state.range(0));
+    
+    UnrolledListModel model;
+    model.reset(makeValues(size));
+    for (auto _ : state) {
+        QStringList result = model.values();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+} // namespace
+
+BENCHMARK(BM_ArrayInsert)->Apply(sizesAndPositions);
+BENCHMARK(BM_ArrayDeleteRefill)->Apply(sizesAndPositions);
+BENCHMARK(BM_ArrayModify)->Apply(sizesAndPositions);
+BENCHMARK(BM_ArrayGetValues)->Apply(sizesOnly);
+BENCHMARK(BM_ArrayGetElementCount)->Apply(sizesOnly);
+BENCHMARK(BM_RingArrayInsert)->Apply(sizesAndPositions);
+BENCHMARK(BM_RingArrayPopPush)->Apply(sizesAndPositions);
+
+BENCHMARK(BM_ListInsert)->Apply(sizesAndPositions);
+BENCHMARK(BM_ListDelete)->Apply(sizesAndPositions);
+BENCHMARK(BM_ListModify)->Apply(sizesAndPositions);
+BENCHMARK(BM_ListGetValues)->Apply(sizesOnly);
+BENCHMARK(BM_ListGetSize)->Apply(sizesOnly);
+
+BENCHMARK(BM_UnrolledInsert)->Apply(sizesAndPositions);
+BENCHMARK(BM_UnrolledDelete)->Apply(sizesAndPositions);
+BENCHMARK(BM_UnrolledModify)->Apply(sizesAndPositions);
+BENCHMARK(BM_UnrolledGetValues)->Apply(sizesOnly);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+// 可视化组件绘制的基准（Google Benchmark），只测 paintEvent：通过 QWidget::render 离屏绘制到 QImage
+// 不需要显示器：未设置 QT_QPA_PLATFORM 时使用 offscreen 平台
+// 参数：元素数 10 ~ 10^5、组件尺寸、动画进度（-1 表示没有动画，否则为弹起动画的百分比）
+// 每帧之前使静态图层失效，测量的是完整的一帧；time 为每帧耗时（µs），per_element 为每个元素的耗时
+// *Overview 为概览模式：整个结构缩小到组件内，元素增多时依次降为简化方框和色带
+// 输出 JSON：render_bench --benchmark_format=json 或 --benchmark_out=render.json
+
+#include <benchmark/benchmark.h>
+#include <QApplication>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include "ArrayWidget.h"
+#include "LinkedListWidget.h"
+#include "UnrolledListWidget.h"
+
+namespace {
+
+const int WIDGET_SIZES[][2] = { { 640, 480 }, { 1280, 800 }, { 1920, 1080 } };
+const int BOUNCING_ELEMENTS = 8;  // 有动画时同时弹起的元素个数（从第一个元素开始，总在可视区域内）
+
+QStringList makeValues(int count)
+{
+    QStringList values;
+    values.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        values << QString::number(i);
+    }
+    return values;
+}
+
+void renderArgs(benchmark::internal::Benchmark *b)
+{
+    for (int size = 10; size <= 100000; size *= 10) {
+        for (int widgetSize = 0; widgetSize < 3; ++widgetSize) {
+            for (int progress : { -1, 25, 50 }) {
+                b->Args({ size, widgetSize, progress });
+            }
+        }
+    }
+}
+
+// 三个组件的初始化、修改和离屏绘制接口相同；组件由调用方构造，以便先设置显示模式
+template <typename Widget>
+void renderFrames(benchmark::State &state, Widget &widget)
+{
+    const int size = static_cast<int>(state.range(0));
+    const int width = WIDGET_SIZES[state.range(1)][0];
+    const int height = WIDGET_SIZES[state.range(1)][1];
+    const int progress = static_cast<int>(state.range(2));
+    const QStringList values = makeValues(size);
+    
+    widget.initialize(values);
+    widget.resize(width, height);
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    widget.render(&image);  // 第一帧求解布局并建立文本缓存，不计时
+    
+    if (progress >= 0) {
+        // 修改为相同的值只为开始高亮和弹起效果；没有事件循环，帧定时器不会推进时间线
+        for (int i = 0; i < BOUNCING_ELEMENTS && i < size; ++i) {
+            widget.modifyElement(i, values[i]);
+        }
+        widget.freezeAnimationClock(AnimationTimeline::BOUNCE_MS * progress / 100);
+    }
+    
+    for (auto _ : state) {
+        widget.invalidateBackground();
+        widget.render(&image);
+        benchmark::DoNotOptimize(image.constBits());
+        benchmark::ClobberMemory();
+    }
+    
+    state.SetLabel(QString("%1x%2 %3").arg(width).arg(height)
+                   .arg(progress < 0 ? QString("static") : QString("bounce %1%").arg(progress)).toStdString());
+    state.counters["per_element"] = benchmark::Counter(size, benchmark::Counter::kIsIterationInvariantRate
+                                                              | benchmark::Counter::kInvert);
+}
+
+void BM_RenderArray(benchmark::State &state)
+{
+    ArrayWidget widget;
+    renderFrames(state, widget);
+}
+
+void BM_RenderArrayOverview(benchmark::State &state)
+{
+    ArrayWidget widget;
+    widget.setOverviewMode(true);
+    renderFrames(state, widget);
+}
+
+void BM_RenderLinkedList(benchmark::State &state)
+{
+    LinkedListWidget widget;
+    renderFrames(state, widget);
+}
+
+void BM_RenderLinkedListOverview(benchmark::State &state)
+{
+    LinkedListWidget widget;
+    widget.setOverviewMode(true);
+    renderFrames(state, widget);
+}
+
+void BM_RenderUnrolledList(benchmark::State &state)
+{
+    UnrolledListWidget widget;
+    renderFrames(state, widget);
+}
+
+} // namespace
+
+BENCHMARK(BM_RenderArray)->Apply(renderArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RenderArrayOverview)->Apply(renderArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RenderLinkedList)->Apply(renderArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RenderLinkedListOverview)->Apply(renderArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RenderUnrolledList)->Apply(renderArgs)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char *argv[])
+{
+    // 没有显示器的 CI 机器上也能运行；已经指定平台时保持不变
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
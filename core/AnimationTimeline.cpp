@@ -0,0 +1,155 @@
+#include "AnimationTimeline.h"
+
+AnimationTimeline::AnimationTimeline()
+    : bounceCurve(QEasingCurve::OutCubic)
+    , enabled(true)
+    , frozenMs(-1)
+{
+    clock.start();
+}
+
+void AnimationTimeline::start(int index, int highlightMs, bool bounce, int tag)
+{
+    if (!enabled) {
+        return;
+    }
+    
+    qint64 now = currentTime();
+    QHash<int, Effect>::iterator it = effects.find(index);
+    if (it == effects.end()) {
+        Effect effect;
+        effect.startMs = now;
+        effect.highlightEndMs = now + highlightMs;
+        effect.highlighted = highlightMs > 0;
+        effect.bouncing = bounce;
+        effect.tag = tag;
+        effects.insert(index, effect);
+        return;
+    }
+    
+    Effect &effect = it.value();
+    if (tag != 0) {
+        effect.tag = tag;
+    }
+    if (highlightMs > 0) {
+        effect.highlightEndMs = qMax(effect.highlightEndMs, now + highlightMs);
+        effect.highlighted = true;
+    }
+    if (bounce) {
+        effect.startMs = now;
+        effect.bouncing = true;
+    }
+}
+
+void AnimationTimeline::shiftIndices(int fromIndex, int delta)
+{
+    if (effects.isEmpty()) {
+        return;
+    }
+    
+    // 索引是哈希键，只能重建；活跃效果通常很少
+    QHash<int, Effect> shifted;
+    shifted.reserve(effects.size());
+    for (QHash<int, Effect>::const_iterator it = effects.constBegin(); it != effects.constEnd(); ++it) {
+        int index = it.key() >= fromIndex ? it.key() + delta : it.key();
+        if (index >= 0) {
+            shifted.insert(index, it.value());
+        }
+    }
+    effects.swap(shifted);
+}
+
+void AnimationTimeline::remove(int index)
+{
+    effects.remove(index);
+}
+
+void AnimationTimeline::clear()
+{
+    effects.clear();
+}
+
+void AnimationTimeline::setEnabled(bool on)
+{
+    enabled = on;
+    if (!enabled) {
+        effects.clear();
+    }
+}
+
+void AnimationTimeline::freezeClock(qint64 offsetMs)
+{
+    frozenMs = offsetMs < 0 ? -1 : clock.elapsed() + offsetMs;
+}
+
+bool AnimationTimeline::isHighlighted(int index) const
+{
+    QHash<int, Effect>::const_iterator it = effects.constFind(index);
+    return it != effects.constEnd() && it.value().highlighted;
+}
+
+int AnimationTimeline::tag(int index) const
+{
+    QHash<int, Effect>::const_iterator it = effects.constFind(index);
+    return it != effects.constEnd() ? it.value().tag : 0;
+}
+
+bool AnimationTimeline::isBouncing(int index) const
+{
+    QHash<int, Effect>::const_iterator it = effects.constFind(index);
+    return it != effects.constEnd() && it.value().bouncing;
+}
+
+qreal AnimationTimeline::bounceHeight(int index) const
+{
+    QHash<int, Effect>::const_iterator it = effects.constFind(index);
+    if (it == effects.constEnd() || !it.value().bouncing) {
+        return 0.0;
+    }
+    
+    // 先升后降：进度 0.5 时最高
+    qreal t = qBound(0.0, qreal(currentTime() - it.value().startMs) / BOUNCE_MS, 1.0);
+    qreal progress = bounceCurve.valueForProgress(t);
+    return 1.0 - qAbs(progress - 0.5) * 2;
+}
+
+QVector<int> AnimationTimeline::bouncingIndices() const
+{
+    QVector<int> result;
+    for (QHash<int, Effect>::const_iterator it = effects.constBegin(); it != effects.constEnd(); ++it) {
+        if (it.value().bouncing) {
+            result << it.key();
+        }
+    }
+    return result;
+}
+
+QVector<int> AnimationTimeline::advance()
+{
+    QVector<int> settled;
+    qint64 now = currentTime();
+    
+    QHash<int, Effect>::iterator it = effects.begin();
+    while (it != effects.end()) {
+        Effect &effect = it.value();
+        bool changed = false;
+        if (effect.bouncing && now - effect.startMs >= BOUNCE_MS) {
+            effect.bouncing = false;
+            changed = true;
+        }
+        if (effect.highlighted && now >= effect.highlightEndMs) {
+            effect.highlighted = false;
+            changed = true;
+        }
+        
+        if (changed) {
+            settled << it.key();
+        }
+        if (!effect.bouncing && !effect.highlighted) {
+            it = effects.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return settled;
+}
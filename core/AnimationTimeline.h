@@ -0,0 +1,59 @@
+#ifndef ANIMATIONTIMELINE_H
+#define ANIMATIONTIMELINE_H
+
+#include <QHash>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QEasingCurve>
+
+// 组件的动画时间线：所有高亮和弹起效果共用一个时钟，按元素索引保存
+// 数据修改立即提交到模型，时间线只负责视觉效果；结构变化时由调用方修正索引
+class AnimationTimeline
+{
+public:
+    static const int BOUNCE_MS = 500;  // 弹起动画时长
+    
+    AnimationTimeline();
+    
+    // 为 index 开始一个效果；该索引已有效果时合并（高亮取较晚的结束时刻，弹起重新开始）
+    // tag 为调用方附加的标记（如展开链表节点的变化类型），随效果一起修正索引，非 0 时覆盖原有标记
+    void start(int index, int highlightMs, bool bounce, int tag = 0);
+    void shiftIndices(int fromIndex, int delta);  // 插入/删除后修正索引 >= fromIndex 的效果
+    void remove(int index);
+    void clear();
+    void setEnabled(bool enabled);  // 关闭后 start() 不再产生效果（如高速回放），并清除进行中的效果
+    bool isEnabled() const { return enabled; }
+    // 把时钟定格在当前时刻之后 offsetMs，进行中的效果按定格的时刻计算进度（离屏渲染基准用）；
+    // offsetMs < 0 时恢复实时
+    void freezeClock(qint64 offsetMs);
+    
+    bool isEmpty() const { return effects.isEmpty(); }
+    int size() const { return effects.size(); }
+    bool isHighlighted(int index) const;
+    bool isBouncing(int index) const;
+    qreal bounceHeight(int index) const;  // 当前弹起高度（0~1），不在弹起中时为 0
+    int tag(int index) const;  // 效果的标记，没有效果时为 0
+    QVector<int> bouncingIndices() const;
+    
+    // 推进到当前时刻，返回弹起或高亮刚结束（需要重绘为静止状态）的索引
+    QVector<int> advance();
+
+private:
+    qint64 currentTime() const { return frozenMs >= 0 ? frozenMs : clock.elapsed(); }
+    
+    struct Effect {
+        qint64 startMs;
+        qint64 highlightEndMs;
+        bool highlighted;
+        bool bouncing;
+        int tag;
+    };
+    
+    QHash<int, Effect> effects;
+    QElapsedTimer clock;
+    QEasingCurve bounceCurve;
+    bool enabled;
+    qint64 frozenMs;  // 定格的时刻，-1 表示实时
+};
+
+#endif // ANIMATIONTIMELINE_H
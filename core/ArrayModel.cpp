@@ -0,0 +1,364 @@
+#include "ArrayModel.h"
+
+ArrayModel::ArrayModel()
+    : headSlot(0)
+    , slotTotal(0)
+    , ringMode(false)
+    , maxElementCount(DEFAULT_MAX_ELEMENTS)
+{
+}
+
+ArrayModel::~ArrayModel()
+{
+    releaseAll();
+}
+
+void ArrayModel::releaseAll()
+{
+    ValuePool &pool = ValuePool::shared();
+    for (int i = 0; i < slotHandles.size(); ++i) {
+        pool.release(slotHandles[i]);
+    }
+}
+
+void ArrayModel::resizeStorage(int size)
+{
+    slotHandles.clear();
+    slotHandles.resize(size);
+    occupied.clear();
+    occupied.resize(size);
+    headSlot = 0;
+    slotTotal = size;
+    costCounter.reallocations++;
+}
+
+void ArrayModel::reset(int size)
+{
+    if (size <= 0) size = 5;  // 默认大小
+    if (size > maxElementCount) size = maxElementCount;  // 限制最大大小
+    
+    // 初始化为空位置，确保所有状态都被清除
+    releaseAll();
+    resizeStorage(size);
+}
+
+void ArrayModel::reset(const QStringList &values)
+{
+    int size = values.size();
+    if (size <= 0) size = 5;  // 默认大小
+    if (size > maxElementCount) size = maxElementCount;  // 限制最大大小
+    
+    releaseAll();
+    resizeStorage(size);
+    
+    // 初始化元素，多出的位置保持为空
+    ValuePool &pool = ValuePool::shared();
+    for (int i = 0; i < size && i < values.size(); ++i) {
+        slotHandles[i] = pool.acquire(values[i]);
+        occupied.setBit(i, true);
+    }
+}
+
+int ArrayModel::insert(int index, const QString &value)
+{
+    // 数组插入：在索引index之后插入
+    // index = -1 表示在开头插入
+    // index >= 0 表示在索引index之后插入
+    // 如果目标位置为空，直接填充；否则插入新位置
+    
+    if (index < -1) {
+        return -1;
+    }
+    
+    int arraySize = slotTotal;
+    int insertPos;
+    bool fillEmpty = false;
+    
+    if (index == -1) {
+        // 在开头插入
+        insertPos = 0;
+    } else if (index >= arraySize) {
+        // 在末尾插入
+        insertPos = arraySize;
+    } else {
+        // 在索引index之后插入
+        insertPos = index + 1;
+    }
+    
+    // 检查目标位置是否为空
+    if (insertPos < arraySize && !occupied.testBit(physicalIndex(insertPos))) {
+        fillEmpty = true;
+    }
+    
+    if (fillEmpty) {
+        // 直接填充空位置
+        int slot = physicalIndex(insertPos);
+        slotHandles[slot] = ValuePool::shared().acquire(value);
+        occupied.setBit(slot, true);
+    } else {
+        // 插入新位置（动态扩展），限制最大元素数量
+        if (arraySize >= maxElementCount) {
+            return -1;
+        }
+        if (ringMode) {
+            insertRingSlot(insertPos, ValuePool::shared().acquire(value));
+        } else {
+            int oldCapacity = slotHandles.capacity();
+            slotHandles.insert(insertPos, ValuePool::shared().acquire(value));
+            occupied.insert(insertPos, true);
+            ++slotTotal;
+            costCounter.moves += arraySize - insertPos;
+            if (slotHandles.capacity() != oldCapacity) {
+                costCounter.reallocations++;
+            }
+        }
+    }
+    
+    return insertPos;
+}
+
+void ArrayModel::insertRingSlot(int index, ValuePool::Handle handle)
+{
+    if (slotTotal == slotHandles.size()) {
+        int grown = slotHandles.size() * 2;
+        relocate(grown < MIN_RING_CAPACITY ? MIN_RING_CAPACITY : grown);
+    }
+    
+    // 前面较短时头部后退一格、[0, index) 前移；否则 [index, size) 后移。两端插入不移动任何元素
+    if (index < slotTotal - index) {
+        headSlot = headSlot == 0 ? slotHandles.size() - 1 : headSlot - 1;
+        ++slotTotal;
+        costCounter.moves += index;
+        for (int i = 0; i < index; ++i) {
+            int from = physicalIndex(i + 1);
+            int to = physicalIndex(i);
+            slotHandles[to] = slotHandles[from];
+            occupied.setBit(to, occupied.testBit(from));
+        }
+    } else {
+        ++slotTotal;
+        costCounter.moves += slotTotal - 1 - index;
+        for (int i = slotTotal - 1; i > index; --i) {
+            int from = physicalIndex(i - 1);
+            int to = physicalIndex(i);
+            slotHandles[to] = slotHandles[from];
+            occupied.setBit(to, occupied.testBit(from));
+        }
+    }
+    
+    int slot = physicalIndex(index);
+    slotHandles[slot] = handle;
+    occupied.setBit(slot, true);
+}
+
+void ArrayModel::relocate(int capacity)
+{
+    QVector<ValuePool::Handle> handles(capacity);
+    PackedFlags flags;
+    flags.resize(capacity);
+    for (int i = 0; i < slotTotal; ++i) {
+        int slot = physicalIndex(i);
+        handles[i] = slotHandles[slot];
+        flags.setBit(i, occupied.testBit(slot));
+    }
+    slotHandles.swap(handles);
+    occupied.swap(flags);
+    headSlot = 0;
+    costCounter.reallocations++;
+}
+
+void ArrayModel::setRingMode(bool enabled)
+{
+    if (ringMode == enabled) {
+        return;
+    }
+    ringMode = enabled;
+    // 非环形模式的其余操作都假定存储从 0 开始且没有多余槽位
+    if (!enabled && (headSlot != 0 || slotHandles.size() != slotTotal)) {
+        relocate(slotTotal);
+    }
+}
+
+int ArrayModel::insertRange(int index, const QStringList &values)
+{
+    // 与逐个调用 insert 的结果相同（每个值插入在上一个值之后），
+    // 但只重新排列一次后续元素：目标位置为空时填充，否则插入新位置
+    if (index < -1 || values.isEmpty()) {
+        return 0;
+    }
+    
+    // 区间插入总要重排一次，环形缓冲区先整理成连续存储，插入后容量等于元素数
+    if (headSlot != 0 || slotHandles.size() != slotTotal) {
+        relocate(slotTotal);
+    }
+    
+    int arraySize = slotTotal;
+    int insertPos = index == -1 ? 0 : qMin(index + 1, arraySize);
+    
+    ValuePool &pool = ValuePool::shared();
+    QVector<ValuePool::Handle> merged;
+    PackedFlags mergedFlags;
+    merged.reserve(qMin(arraySize + values.size(), qMax(arraySize, maxElementCount)));
+    for (int i = 0; i < insertPos; ++i) {
+        merged.append(slotHandles[i]);
+        mergedFlags.append(occupied.testBit(i));
+    }
+    
+    int source = insertPos;  // 原数组中下一个待处理的位置
+    int grown = 0;
+    int inserted = 0;
+    for (const QString &value : values) {
+        if (source < arraySize && !occupied.testBit(source)) {
+            // 直接填充空位置
+            ++source;
+        } else if (arraySize + grown >= maxElementCount) {
+            break;  // 达到元素数量上限
+        } else {
+            ++grown;
+        }
+        merged.append(pool.acquire(value));
+        mergedFlags.append(true);
+        ++inserted;
+    }
+    
+    for (int i = source; i < arraySize; ++i) {
+        merged.append(slotHandles[i]);
+        mergedFlags.append(occupied.testBit(i));
+    }
+    // 合并结果总在新存储中；新增了位置时插入点之后的元素整体后移
+    costCounter.reallocations++;
+    if (grown > 0) {
+        costCounter.moves += arraySize - source;
+    }
+    slotHandles.swap(merged);
+    occupied.swap(mergedFlags);
+    slotTotal = slotHandles.size();
+    return inserted;
+}
+
+int ArrayModel::eraseRange(int index, int count, int *frontPopped)
+{
+    // 环形模式下删除开头的元素会移除该位置，后面的元素补上来，此时停在原索引继续删除
+    int erased = 0;
+    int popped = 0;
+    int position = qMax(0, index);
+    for (int remaining = qMin(index + count, slotTotal) - position; remaining > 0; --remaining) {
+        int oldSize = slotTotal;
+        if (erase(position)) {
+            ++erased;
+        }
+        if (slotTotal == oldSize) {
+            ++position;
+        } else if (position == 0) {
+            ++popped;
+        }
+    }
+    if (frontPopped) {
+        *frontPopped = popped;
+    }
+    return erased;
+}
+
+int ArrayModel::append(const QStringList &values)
+{
+    // 不预留精确容量：分块追加时由 QVector（或环形缓冲区的加倍扩容）按倍数增长，总开销保持线性
+    ValuePool &pool = ValuePool::shared();
+    int count = qMin(values.size(), qMax(0, maxElementCount - slotTotal));
+    for (int i = 0; i < count; ++i) {
+        if (ringMode) {
+            insertRingSlot(slotTotal, pool.acquire(values[i]));
+        } else {
+            int oldCapacity = slotHandles.capacity();
+            slotHandles.append(pool.acquire(values[i]));
+            occupied.append(true);
+            ++slotTotal;
+            if (slotHandles.capacity() != oldCapacity) {
+                costCounter.reallocations++;
+            }
+        }
+    }
+    return count;
+}
+
+bool ArrayModel::erase(int index)
+{
+    if (isEmpty(index)) {
+        return false;  // 越界或该位置已经为空
+    }
+    
+    int slot = physicalIndex(index);
+    occupied.setBit(slot, false);
+    ValuePool::shared().release(slotHandles[slot]);
+    slotHandles[slot] = ValuePool::EMPTY_HANDLE;
+    
+    // 环形模式下两端出队：头部前进一格或尾部回退一格
+    if (ringMode && (index == 0 || index == slotTotal - 1)) {
+        if (index == 0) {
+            headSlot = headSlot + 1 == slotHandles.size() ? 0 : headSlot + 1;
+        }
+        --slotTotal;
+    }
+    return true;
+}
+
+bool ArrayModel::modify(int index, const QString &value)
+{
+    if (isEmpty(index)) {
+        return false;  // 越界或该位置为空，不能修改
+    }
+    
+    // 先取得新值再归还旧值，值不变时不会被回收后重新加入
+    int slot = physicalIndex(index);
+    ValuePool &pool = ValuePool::shared();
+    ValuePool::Handle handle = pool.acquire(value);
+    pool.release(slotHandles[slot]);
+    slotHandles[slot] = handle;
+    return true;
+}
+
+int ArrayModel::count() const
+{
+    // 未使用的槽位标志为 0，按物理存储整体计数即可
+    return occupied.count();
+}
+
+QStringList ArrayModel::values() const
+{
+    QStringList result;
+    const ValuePool &pool = ValuePool::shared();
+    result.reserve(occupied.count());
+    for (int i = 0; i < slotTotal; ++i) {
+        int slot = physicalIndex(i);
+        if (occupied.testBit(slot)) {
+            result << pool.value(slotHandles[slot]);
+        }
+    }
+    return result;
+}
+
+bool ArrayModel::isEmpty(int index) const
+{
+    return !isValidIndex(index) || !occupied.testBit(physicalIndex(index));
+}
+
+QString ArrayModel::value(int index) const
+{
+    return isValidIndex(index) ? ValuePool::shared().value(slotHandles[physicalIndex(index)]) : QString();
+}
+
+int ArrayModel::logicalIndex(int slot) const
+{
+    if (slot < 0 || slot >= slotHandles.size()) {
+        return -1;
+    }
+    int index = slot - headSlot;
+    if (index < 0) {
+        index += slotHandles.size();
+    }
+    return index < slotTotal ? index : -1;
+}
+
+void ArrayModel::setMaxElements(int limit)
+{
+    maxElementCount = qMax(1, limit);
+}
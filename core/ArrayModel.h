@@ -0,0 +1,81 @@
+#ifndef ARRAYMODEL_H
+#define ARRAYMODEL_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include "OpCost.h"
+#include "PackedFlags.h"
+#include "ValuePool.h"
+
+// 数组的数据模型（不依赖界面，只依赖 QtCore）
+// 位置可以为空：删除只清空该位置，插入时优先填充空位置
+// 按列存储：值句柄一列（值本身在共用的 ValuePool 中），占用标志压缩为位列；
+// 元素位置由界面按网格参数计算，不在模型中保存
+// 环形模式：两列作为环形缓冲区，逻辑索引 0 对应物理槽位 headSlot，
+// - 在开头或末尾插入新位置是 O(1)（容量满时加倍），中间插入只移动较短的一侧
+// - 删除两端的元素时位置一起移除（出队），删除中间的元素仍只清空
+class ArrayModel
+{
+public:
+    static const int DEFAULT_MAX_ELEMENTS = 1000000;  // 默认元素上限
+    
+    ArrayModel();
+    ~ArrayModel();
+    
+    void reset(int size);  // 创建 size 个空位置
+    void reset(const QStringList &values);
+    int insert(int index, const QString &value);  // 在索引index之后插入，返回实际位置，失败返回 -1
+    int insertRange(int index, const QStringList &values);  // 等价于依次在上一个插入位置之后插入，返回插入个数
+    int append(const QStringList &values);  // 在末尾追加（不填充空位），返回追加个数，用于分块加载
+    bool erase(int index);  // 清空该位置，位置保留（环形模式下两端的位置一起移除）
+    // 清空 [index, index+count) 中的非空位置，返回清空个数（两端出队后停在原索引继续）
+    // frontPopped 不为空时返回从开头出队的个数，它们是原索引 [0, frontPopped)；其余出队的位置在原来的末尾
+    int eraseRange(int index, int count, int *frontPopped = nullptr);
+    bool modify(int index, const QString &value);
+    
+    int size() const { return slotTotal; }  // 数组容量
+    int count() const;  // 实际元素数量
+    QStringList values() const;
+    bool isValidIndex(int index) const { return index >= 0 && index < slotTotal; }
+    bool isEmpty(int index) const;
+    QString value(int index) const;
+    
+    void setRingMode(bool enabled);  // 关闭时把环形缓冲区整理回从 0 开始的连续存储
+    bool isRingMode() const { return ringMode; }
+    int capacity() const { return slotHandles.size(); }  // 物理槽位数，非环形模式下等于 size()
+    // 逻辑索引与物理槽位的换算；未使用的槽位（只在环形模式下存在）对应逻辑索引 -1
+    int physicalIndex(int index) const
+    {
+        int slot = headSlot + index;
+        return slot >= slotHandles.size() ? slot - slotHandles.size() : slot;
+    }
+    int logicalIndex(int slot) const;
+    
+    // 累计开销：插入时后移的元素个数（moves）和值句柄列的重新分配次数（reallocations）
+    const OpCost &cost() const { return costCounter; }
+    
+    void setMaxElements(int limit);
+    int maxElements() const { return maxElementCount; }
+
+private:
+    ArrayModel(const ArrayModel &);
+    ArrayModel &operator=(const ArrayModel &);
+    
+    void releaseAll();  // 归还全部句柄的引用
+    void resizeStorage(int size);  // 连续存储 size 个空位置
+    void insertRingSlot(int index, ValuePool::Handle handle);  // 环形模式下在 index 处新增位置
+    void relocate(int capacity);  // 按逻辑顺序搬到容量为 capacity 的新存储，headSlot 归零
+    
+    QVector<ValuePool::Handle> slotHandles;  // 按物理槽位存放，空位置和未使用的槽位为 EMPTY_HANDLE
+    PackedFlags occupied;  // 位置是否有元素
+    int headSlot;  // 逻辑索引 0 所在的物理槽位，非环形模式下始终为 0
+    int slotTotal;  // 逻辑位置数
+    bool ringMode;
+    int maxElementCount;
+    OpCost costCounter;
+    
+    static const int MIN_RING_CAPACITY = 8;  // 环形缓冲区第一次扩容后的最小容量
+};
+
+#endif // ARRAYMODEL_H
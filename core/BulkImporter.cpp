@@ -0,0 +1,123 @@
+#include "BulkImporter.h"
+#include <QFile>
+#include <QThread>
+
+namespace {
+
+inline bool isSeparator(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+} // namespace
+
+BulkImporter::BulkImporter(const QString &path, int maxValues, QObject *parent)
+    : QObject(parent)
+    , path(path)
+    , maxValues(maxValues)
+    , cancelled(0)
+    , pendingChunks(0)
+{
+}
+
+void BulkImporter::run()
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        emit failed(file.errorString());
+        return;
+    }
+
+    qint64 total = file.size();
+    QStringList chunk;
+    chunk.reserve(CHUNK_SIZE);
+    QByteArray carry;  // 跨越映射窗口边界、尚未结束的值
+    int count = 0;
+    bool stopped = false;
+
+    // 文件按窗口分段映射，地址空间占用与文件大小无关
+    for (qint64 offset = 0; offset < total && !stopped; offset += MAP_WINDOW) {
+        qint64 length = total - offset;
+        if (length > MAP_WINDOW) {
+            length = MAP_WINDOW;
+        }
+        uchar *mapped = file.map(offset, length);
+        if (!mapped) {
+            emit failed(file.errorString());
+            return;
+        }
+
+        const char *bytes = reinterpret_cast<const char *>(mapped);
+        qint64 start = -1;  // 当前窗口内正在读取的值的起点
+        for (qint64 pos = 0; pos < length; ++pos) {
+            if (!isSeparator(bytes[pos])) {
+                if (start < 0) {
+                    start = pos;
+                }
+                continue;
+            }
+            if (start < 0 && carry.isEmpty()) {
+                continue;
+            }
+
+            // 一个值结束：直接从映射内存解码，只有跨窗口的值才经过 carry 拼接
+            if (carry.isEmpty()) {
+                chunk << QString::fromUtf8(bytes + start, int(pos - start));
+            } else {
+                if (start >= 0) {
+                    carry.append(bytes + start, int(pos - start));
+                }
+                chunk << QString::fromUtf8(carry);
+                carry.clear();
+            }
+            start = -1;
+            ++count;
+
+            if (count >= maxValues) {
+                stopped = true;
+                break;
+            }
+            if (chunk.size() >= CHUNK_SIZE) {
+                emit progress(offset + pos, total);
+                if (!emitChunk(chunk)) {
+                    stopped = true;
+                    break;
+                }
+            }
+        }
+        if (!stopped && start >= 0) {
+            carry.append(bytes + start, int(length - start));
+        }
+        file.unmap(mapped);
+    }
+
+    // 文件末尾没有空白时，最后一个值还留在 carry 中
+    if (!stopped && !carry.isEmpty() && count < maxValues) {
+        chunk << QString::fromUtf8(carry);
+        ++count;
+    }
+
+    bool wasCancelled = cancelled.loadAcquire() != 0;
+    if (!wasCancelled && !chunk.isEmpty()) {
+        emitChunk(chunk);
+    }
+    emit progress(total, total);
+    emit finished(count, wasCancelled);
+}
+
+bool BulkImporter::emitChunk(QStringList &chunk)
+{
+    pendingChunks.ref();
+    emit chunkReady(chunk);
+    chunk.clear();
+    chunk.reserve(CHUNK_SIZE);
+
+    // 接收方（界面线程）处理不过来时暂停，避免排队的块占用整个文件大小的内存
+    while (pendingChunks.loadAcquire() >= MAX_PENDING_CHUNKS) {
+        if (cancelled.loadAcquire()) {
+            return false;
+        }
+        QThread::msleep(1);
+    }
+    return cancelled.loadAcquire() == 0;
+}
@@ -0,0 +1,45 @@
+#ifndef BULKIMPORTER_H
+#define BULKIMPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QAtomicInt>
+
+// 从文件批量导入初始化数据：在工作线程中分段映射文件，按空白字符（空格、制表符、换行）切分，
+// 每凑满一块就通过 chunkReady 发出，不会一次性生成整个文件的 QStringList
+// 用法：moveToThread 后把 QThread::started 连接到 run()；cancel() 和 chunkConsumed() 可在任意线程直接调用
+class BulkImporter : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void chunkReady(const QStringList &values);
+    void progress(qint64 bytesRead, qint64 totalBytes);
+    void finished(int count, bool cancelled);
+    void failed(const QString &message);
+
+public:
+    static const int CHUNK_SIZE = 4096;  // 每块的值个数
+    static const int MAX_PENDING_CHUNKS = 8;  // 接收方未处理的块达到该数量时暂停读取
+
+    BulkImporter(const QString &path, int maxValues, QObject *parent = nullptr);
+
+    void cancel() { cancelled.storeRelease(1); }
+    void chunkConsumed() { pendingChunks.deref(); }  // 接收方处理完一块后调用
+
+public slots:
+    void run();
+
+private:
+    bool emitChunk(QStringList &chunk);  // 发出当前块并等待接收方跟上，被取消时返回 false
+
+    QString path;
+    int maxValues;
+    QAtomicInt cancelled;
+    QAtomicInt pendingChunks;
+
+    static const qint64 MAP_WINDOW = 16 * 1024 * 1024;  // 每次映射的字节数
+};
+
+#endif // BULKIMPORTER_H
@@ -0,0 +1,92 @@
+#include "InputTokenizer.h"
+#include <QChar>
+#include <QtAlgorithms>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INPUTTOKENIZER_SSE2
+#endif
+
+namespace {
+
+// ASCII 空白直接比较，其余字符交给 QChar::isSpace（如全角空格 U+3000）
+inline bool isSpaceUnit(ushort c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r') || (c >= 0x80 && QChar(c).isSpace());
+}
+
+} // namespace
+
+int InputTokenizer::count(QStringView text, int limit)
+{
+    const ushort *data = reinterpret_cast<const ushort *>(text.utf16());
+    const qsizetype size = text.size();
+    qsizetype pos = 0;
+    int tokens = 0;
+    uint previousSpace = 1;  // 上一个字符是否为空白，文本开头视为空白
+
+#ifdef INPUTTOKENIZER_SSE2
+    // 每次比较 8 个字符：得到空白位掩码后，“非空白且前一个是空白”的位就是一个值的开头
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nonAsciiBits = _mm_set1_epi16(short(0xFF80));
+    const __m128i space = _mm_set1_epi16(' ');
+    const __m128i belowTab = _mm_set1_epi16('\t' - 1);
+    const __m128i aboveCr = _mm_set1_epi16('\r' + 1);
+    while (pos + 8 <= size && tokens < limit) {
+        __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(units, nonAsciiBits), zero);
+        if (_mm_movemask_epi8(ascii) != 0xFFFF) {
+            // 含非 ASCII 字符的 8 个字符逐个判断
+            for (qsizetype end = pos + 8; pos < end; ++pos) {
+                uint isSpace = isSpaceUnit(data[pos]) ? 1 : 0;
+                if (!isSpace && previousSpace) {
+                    ++tokens;
+                }
+                previousSpace = isSpace;
+            }
+            continue;
+        }
+
+        __m128i spaces = _mm_or_si128(_mm_cmpeq_epi16(units, space),
+                                      _mm_and_si128(_mm_cmpgt_epi16(units, belowTab),
+                                                    _mm_cmplt_epi16(units, aboveCr)));
+        uint mask = uint(_mm_movemask_epi8(_mm_packs_epi16(spaces, zero))) & 0xFF;
+        uint starts = ~mask & ((mask << 1) | previousSpace) & 0xFF;
+        tokens += qPopulationCount(starts);
+        previousSpace = (mask >> 7) & 1;
+        pos += 8;
+    }
+#endif
+
+    for (; pos < size && tokens < limit; ++pos) {
+        uint isSpace = isSpaceUnit(data[pos]) ? 1 : 0;
+        if (!isSpace && previousSpace) {
+            ++tokens;
+        }
+        previousSpace = isSpace;
+    }
+    return qMin(tokens, limit);
+}
+
+QStringList InputTokenizer::tokenize(QStringView text, int limit)
+{
+    QStringList result;
+    result.reserve(count(text, limit));
+
+    const ushort *data = reinterpret_cast<const ushort *>(text.utf16());
+    const qsizetype size = text.size();
+    qsizetype pos = 0;
+    while (pos < size && result.size() < limit) {
+        while (pos < size && isSpaceUnit(data[pos])) {
+            ++pos;
+        }
+        qsizetype start = pos;
+        while (pos < size && !isSpaceUnit(data[pos])) {
+            ++pos;
+        }
+        if (pos > start) {
+            result << text.mid(start, pos - start).toString();
+        }
+    }
+    return result;
+}
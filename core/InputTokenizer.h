@@ -0,0 +1,19 @@
+#ifndef INPUTTOKENIZER_H
+#define INPUTTOKENIZER_H
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+// 按空白字符（与 QChar::isSpace 相同）切分输入文本
+// count() 只扫描不分配内存，用于输入时的实时提示；tokenize() 在真正初始化时才生成字符串
+class InputTokenizer
+{
+public:
+    // 返回值的个数，达到 limit 时提前结束并返回 limit
+    static int count(QStringView text, int limit);
+    // 返回前 limit 个值
+    static QStringList tokenize(QStringView text, int limit);
+};
+
+#endif // INPUTTOKENIZER_H
@@ -0,0 +1,27 @@
+#ifndef LINEAROP_H
+#define LINEAROP_H
+
+#include <QString>
+#include <QVector>
+
+// 一次插入/删除/修改操作，供批量接口使用
+// 索引含义与对应的单个操作相同：插入时在索引之后插入（-1 表示开头）
+struct LinearOp {
+    enum Type {
+        Insert,
+        Delete,
+        Modify
+    };
+    
+    Type type;
+    int index;
+    QString value;  // 删除操作忽略该值
+    
+    LinearOp() : type(Insert), index(-1) {}
+    LinearOp(Type type, int index, const QString &value = QString())
+        : type(type), index(index), value(value) {}
+};
+
+typedef QVector<LinearOp> LinearOpList;
+
+#endif // LINEAROP_H
@@ -0,0 +1,327 @@
+#include "LinkedListModel.h"
+
+LinkedListModel::LinkedListModel()
+    : headNode(nullptr)
+    , tailNode(nullptr)
+    , listSize(0)
+    , maxElementCount(DEFAULT_MAX_ELEMENTS)
+    , nextFinger(0)
+{
+}
+
+LinkedListModel::~LinkedListModel()
+{
+    clear();
+}
+
+void LinkedListModel::clear()
+{
+    // 逐个归还值并析构节点后，整体回收节点池中的全部槽位
+    ValuePool &pool = ValuePool::shared();
+    ListNode *current = headNode;
+    while (current) {
+        ListNode *next = current->next;
+        pool.release(current->valueHandle);
+        nodePool.discard(current);
+        current = next;
+    }
+    nodePool.reset();
+    headNode = nullptr;
+    tailNode = nullptr;
+    listSize = 0;
+    resetFingers();
+}
+
+void LinkedListModel::ensureHead()
+{
+    if (!headNode) {
+        headNode = nodePool.allocate();
+        headNode->valueHandle = ValuePool::shared().acquire("头节点");
+        costCounter.allocations++;
+    }
+}
+
+void LinkedListModel::reset(int size)
+{
+    clear();
+    
+    if (size > maxElementCount) {
+        size = maxElementCount;  // 限制最大大小
+    }
+    if (size <= 0) {
+        return;
+    }
+    
+    ensureHead();
+    ListNode *current = headNode;
+    for (int i = 0; i < size; ++i) {
+        ListNode *newNode = nodePool.allocate();
+        newNode->valueHandle = ValuePool::defaultLabel(i);
+        newNode->prev = current;
+        current->next = newNode;
+        current = newNode;
+    }
+    tailNode = current;
+    listSize = size;
+    costCounter.allocations += size;
+}
+
+void LinkedListModel::reset(const QStringList &values)
+{
+    clear();
+    
+    if (values.isEmpty()) {
+        return;
+    }
+    
+    int size = qMin(values.size(), maxElementCount);  // 限制最大大小
+    
+    ensureHead();
+    ValuePool &pool = ValuePool::shared();
+    ListNode *current = headNode;
+    for (int i = 0; i < size; ++i) {
+        ListNode *newNode = nodePool.allocate();
+        newNode->valueHandle = pool.acquire(values[i]);
+        newNode->prev = current;
+        current->next = newNode;
+        current = newNode;
+    }
+    tailNode = current;
+    listSize = size;
+    costCounter.allocations += size;
+}
+
+ListNode *LinkedListModel::nodeAt(int index)
+{
+    // 返回索引为index的实际节点（不包括头节点）
+    // index从0开始，对应第一个实际节点
+    if (index < 0 || index >= listSize || !headNode) {
+        return nullptr;
+    }
+    
+    // 从第一个节点、最后一个节点和最近访问过的节点中选离目标最近的一个出发，
+    // 向前或向后走；顺序访问时每次只需走一步
+    ListNode *current = headNode->next;
+    int count = 0;
+    if (listSize - 1 - index < index) {
+        current = tailNode;
+        count = listSize - 1;
+    }
+    for (int i = 0; i < FINGER_COUNT; ++i) {
+        if (fingers[i].node && qAbs(fingers[i].index - index) < qAbs(count - index)) {
+            current = fingers[i].node;
+            count = fingers[i].index;
+        }
+    }
+    
+    int start = count;
+    while (current && count < index) {
+        current = current->next;
+        count++;
+    }
+    while (current && count > index) {
+        current = current->prev;
+        count--;
+    }
+    costCounter.hops += qAbs(count - start);
+    
+    if (current) {
+        rememberFinger(index, current);
+    }
+    return current;
+}
+
+int LinkedListModel::insertAfter(int index, const QString &value)
+{
+    // 支持在任意位置插入，包括在末尾之后
+    // index = -1: 在开头插入
+    // index >= 0: 在索引index之后插入（如果index >= listSize，则在末尾插入）
+    
+    if (index < -1 || listSize >= maxElementCount) {
+        return -1;
+    }
+    
+    ensureHead();
+    
+    ListNode *prev = nullptr;
+    int insertIndex = 0;
+    
+    if (index == -1) {
+        // 在开头插入
+        prev = headNode;
+        insertIndex = 0;
+    } else if (index >= listSize) {
+        // 在末尾插入：直接使用尾指针，链表为空时使用头节点作为前驱
+        prev = tailNode ? tailNode : headNode;
+        insertIndex = listSize;
+    } else {
+        // 在索引index之后插入
+        prev = nodeAt(index);
+        insertIndex = index + 1;
+    }
+    
+    if (!prev) {
+        return -1;
+    }
+    
+    ListNode *newNode = nodePool.allocate();
+    newNode->valueHandle = ValuePool::shared().acquire(value);
+    costCounter.allocations++;
+    newNode->next = prev->next;
+    newNode->prev = prev;
+    if (prev->next) {
+        prev->next->prev = newNode;
+    } else {
+        tailNode = newNode;
+    }
+    prev->next = newNode;
+    
+    // 插入点之后的节点索引加一，并记住新节点以便连续插入
+    shiftFingers(insertIndex, 1);
+    rememberFinger(insertIndex, newNode);
+    
+    listSize++;
+    return insertIndex;
+}
+
+void LinkedListModel::removeNode(ListNode *node, int index)
+{
+    if (!node || node == headNode) {
+        return;
+    }
+    
+    // 前驱和后继都由节点本身得到，不需要遍历
+    node->prev->next = node->next;
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        tailNode = node->prev == headNode ? nullptr : node->prev;
+    }
+    
+    // 被删除节点之后的指针索引减一
+    dropFinger(node);
+    shiftFingers(index + 1, -1);
+    ValuePool::shared().release(node->valueHandle);
+    nodePool.release(node);
+    
+    listSize--;
+}
+
+bool LinkedListModel::removeAt(int index)
+{
+    ListNode *node = nodeAt(index);
+    if (!node) {
+        return false;
+    }
+    removeNode(node, index);
+    return true;
+}
+
+int LinkedListModel::insertRange(int index, const QStringList &values)
+{
+    // 每次插入后新节点都记在指针缓存中，下一次插入不需要重新遍历
+    int inserted = 0;
+    int at = index;
+    for (const QString &value : values) {
+        at = insertAfter(at, value);
+        if (at < 0) {
+            break;  // 达到节点数量上限
+        }
+        ++inserted;
+    }
+    return inserted;
+}
+
+int LinkedListModel::removeRange(int index, int count)
+{
+    // 只定位一次起始节点，之后沿后继逐个删除
+    ListNode *node = nodeAt(index);
+    int removed = 0;
+    while (node && removed < count) {
+        ListNode *next = node->next;
+        removeNode(node, index);
+        node = next;
+        ++removed;
+    }
+    return removed;
+}
+
+QString LinkedListModel::value(int index)
+{
+    ListNode *node = nodeAt(index);
+    return node ? valueOf(node) : QString();
+}
+
+bool LinkedListModel::modify(int index, const QString &value)
+{
+    ListNode *node = nodeAt(index);
+    if (!node) {
+        return false;
+    }
+    // 先取得新值再归还旧值，值不变时不会被回收后重新加入
+    ValuePool &pool = ValuePool::shared();
+    ValuePool::Handle handle = pool.acquire(value);
+    pool.release(node->valueHandle);
+    node->valueHandle = handle;
+    return true;
+}
+
+QStringList LinkedListModel::values() const
+{
+    QStringList result;
+    result.reserve(listSize);
+    ListNode *current = headNode;
+    if (current) {
+        current = current->next; // 跳过头节点
+    }
+    while (current) {
+        result << valueOf(current);
+        current = current->next;
+    }
+    return result;
+}
+
+void LinkedListModel::setMaxElements(int limit)
+{
+    maxElementCount = qMax(1, limit);
+}
+
+void LinkedListModel::resetFingers()
+{
+    for (int i = 0; i < FINGER_COUNT; ++i) {
+        fingers[i] = NodeFinger();
+    }
+    nextFinger = 0;
+}
+
+void LinkedListModel::rememberFinger(int index, ListNode *node)
+{
+    for (int i = 0; i < FINGER_COUNT; ++i) {
+        if (fingers[i].index == index) {
+            fingers[i].node = node;
+            return;
+        }
+    }
+    
+    fingers[nextFinger].index = index;
+    fingers[nextFinger].node = node;
+    nextFinger = (nextFinger + 1) % FINGER_COUNT;
+}
+
+void LinkedListModel::shiftFingers(int fromIndex, int delta)
+{
+    for (int i = 0; i < FINGER_COUNT; ++i) {
+        if (fingers[i].node && fingers[i].index >= fromIndex) {
+            fingers[i].index += delta;
+        }
+    }
+}
+
+void LinkedListModel::dropFinger(ListNode *node)
+{
+    for (int i = 0; i < FINGER_COUNT; ++i) {
+        if (fingers[i].node == node) {
+            fingers[i] = NodeFinger();
+        }
+    }
+}
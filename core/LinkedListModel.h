@@ -0,0 +1,84 @@
+#ifndef LINKEDLISTMODEL_H
+#define LINKEDLISTMODEL_H
+
+#include <QString>
+#include <QStringList>
+#include "NodePool.h"
+#include "OpCost.h"
+#include "ValuePool.h"
+
+// 节点不保存自身索引：索引由遍历时的计数得到，插入删除不需要重新编号
+// 值保存为共用 ValuePool 中的句柄，通过 LinkedListModel::valueOf() 读取
+struct ListNode {
+    ValuePool::Handle valueHandle;
+    ListNode *next;
+    ListNode *prev;  // 第一个实际节点的前驱是头节点，头节点没有前驱
+    
+    ListNode() : valueHandle(ValuePool::EMPTY_HANDLE), next(nullptr), prev(nullptr) {}
+};
+
+// 最近访问过的（索引, 节点）对，按索引查找时从最近的一个出发
+struct NodeFinger {
+    int index;
+    ListNode *node;
+    
+    NodeFinger() : index(-1), node(nullptr) {}
+};
+
+// 带头节点和尾指针的双向链表数据模型（不依赖界面，只依赖 QtCore）
+// 在末尾插入是 O(1)；按索引查找从头、尾或最近访问过的节点中离目标最近的一个出发，可以向前走
+class LinkedListModel
+{
+public:
+    static const int DEFAULT_MAX_ELEMENTS = 1000000;  // 默认节点上限
+    
+    LinkedListModel();
+    ~LinkedListModel();
+    
+    void clear();
+    void reset(int size);  // 创建 size 个默认标签的节点（标签读取时才生成）
+    void reset(const QStringList &values);
+    int insertAfter(int index, const QString &value);  // 在索引index之后插入（-1 表示开头），返回新节点索引，失败返回 -1
+    int insertRange(int index, const QStringList &values);  // 依次在上一个插入的节点之后插入，返回插入个数
+    void removeNode(ListNode *node, int index);  // 删除已经持有的节点，O(1)；index 为该节点的索引
+    bool removeAt(int index);
+    int removeRange(int index, int count);  // 删除 [index, index+count) 的节点，返回删除个数
+    bool modify(int index, const QString &value);
+    
+    ListNode *head() const { return headNode; }
+    ListNode *tail() const { return tailNode; }  // 最后一个实际节点，链表为空时为 nullptr
+    ListNode *nodeAt(int index);
+    QString valueOf(const ListNode *node) const { return ValuePool::shared().value(node->valueHandle); }
+    QString value(int index);  // 索引越界时返回空字符串
+    int size() const { return listSize; }
+    QStringList values() const;
+    NodePoolStats poolStats() const { return nodePool.stats(); }
+    // 累计开销：按索引查找时沿指针走的步数（hops）和节点分配次数（allocations）
+    const OpCost &cost() const { return costCounter; }
+    
+    void setMaxElements(int limit);
+    int maxElements() const { return maxElementCount; }
+
+private:
+    LinkedListModel(const LinkedListModel &);
+    LinkedListModel &operator=(const LinkedListModel &);
+    
+    void ensureHead();
+    void resetFingers();
+    void rememberFinger(int index, ListNode *node);
+    void shiftFingers(int fromIndex, int delta);  // 结构变化后修正索引 >= fromIndex 的指针
+    void dropFinger(ListNode *node);
+    
+    ListNode *headNode;
+    ListNode *tailNode;
+    int listSize;
+    NodePool<ListNode> nodePool;  // 所有节点（包括头节点）都从节点池分配
+    int maxElementCount;
+    OpCost costCounter;
+    
+    static const int FINGER_COUNT = 4;
+    NodeFinger fingers[FINGER_COUNT];
+    int nextFinger;  // 下一个被替换的指针槽（轮换）
+};
+
+#endif // LINKEDLISTMODEL_H
@@ -0,0 +1,131 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <new>
+
+// 节点池统计信息
+struct NodePoolStats {
+    int liveNodes;      // 当前存活的节点数
+    int slabCount;      // 已分配的内存块数
+    qint64 reuseHits;   // 使用已回收槽位完成的分配次数
+
+    NodePoolStats() : liveNodes(0), slabCount(0), reuseHits(0) {}
+};
+
+// 按块（slab）分配节点的内存池
+// - allocate()/release() 都是 O(1)，释放的槽位挂到空闲链表上复用
+// - reset() 一次性回收所有槽位，但保留内存块供下次初始化复用
+// - 同一块内的节点地址连续，遍历链表时缓存局部性更好
+template <typename T>
+class NodePool
+{
+public:
+    static const int SLAB_SIZE = 1024;  // 每个内存块容纳的节点数
+
+    NodePool()
+        : freeList(nullptr)
+        , currentSlab(0)
+        , slabCursor(0)
+        , carvedSlots(0)
+        , highWater(0)
+        , liveNodes(0)
+        , reuseHits(0)
+    {
+    }
+
+    ~NodePool()
+    {
+        for (int i = 0; i < slabs.size(); ++i) {
+            ::operator delete(slabs[i]);
+        }
+    }
+
+    T *allocate()
+    {
+        void *slot = nullptr;
+        if (freeList) {
+            // 优先复用单独释放的槽位
+            slot = freeList;
+            freeList = freeList->next;
+            ++reuseHits;
+        } else {
+            if (currentSlab == slabs.size()) {
+                slabs.append(static_cast<char *>(::operator new(sizeof(T) * SLAB_SIZE)));
+            }
+            slot = slabs[currentSlab] + slabCursor * sizeof(T);
+            // reset() 之前用过的槽位也算复用
+            if (carvedSlots < highWater) {
+                ++reuseHits;
+            }
+            ++carvedSlots;
+            if (++slabCursor == SLAB_SIZE) {
+                ++currentSlab;
+                slabCursor = 0;
+            }
+        }
+        ++liveNodes;
+        return new (slot) T();
+    }
+
+    void release(T *node)
+    {
+        if (!node) {
+            return;
+        }
+        node->~T();
+        FreeSlot *slot = reinterpret_cast<FreeSlot *>(node);
+        slot->next = freeList;
+        freeList = slot;
+        --liveNodes;
+    }
+
+    // 只析构对象、不回收槽位，配合 reset() 批量释放
+    void discard(T *node)
+    {
+        if (node) {
+            node->~T();
+        }
+    }
+
+    // 批量回收全部槽位：调用前所有存活节点必须已经 discard()/release()
+    void reset()
+    {
+        highWater = qMax(highWater, carvedSlots);
+        freeList = nullptr;
+        currentSlab = 0;
+        slabCursor = 0;
+        carvedSlots = 0;
+        liveNodes = 0;
+    }
+
+    NodePoolStats stats() const
+    {
+        NodePoolStats result;
+        result.liveNodes = liveNodes;
+        result.slabCount = slabs.size();
+        result.reuseHits = reuseHits;
+        return result;
+    }
+
+private:
+    struct FreeSlot {
+        FreeSlot *next;
+    };
+    static_assert(sizeof(T) >= sizeof(FreeSlot), "node type too small for the free list");
+
+    NodePool(const NodePool &);
+    NodePool &operator=(const NodePool &);
+
+    QVector<char *> slabs;
+    FreeSlot *freeList;
+    int currentSlab;   // 正在切分的内存块
+    int slabCursor;    // 当前块内下一个未使用的槽位
+    qint64 carvedSlots;  // 本轮 reset() 以来从内存块切出的槽位数
+    qint64 highWater;    // 历史上切出槽位的最大值
+    int liveNodes;
+    qint64 reuseHits;
+};
+
+#endif // NODEPOOL_H
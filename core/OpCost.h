@@ -0,0 +1,61 @@
+#ifndef OPCOST_H
+#define OPCOST_H
+
+#include <QtGlobal>
+
+// 操作的实际开销计数，各数据模型只累加与自身有关的几项：
+// - 数组：插入时后移的元素个数、存储重新分配的次数
+// - 链表：按索引查找时沿指针走的步数、节点分配次数
+// - 展开链表：节点内移动的值个数、跨节点走的步数、节点分配次数
+struct OpCost {
+    qint64 moves;  // 元素（值句柄）的移动次数
+    qint64 reallocations;  // 存储整体重新分配的次数
+    qint64 hops;  // 沿 next/prev 指针走的步数
+    qint64 allocations;  // 节点分配次数
+
+    OpCost() : moves(0), reallocations(0), hops(0), allocations(0) {}
+
+    OpCost &operator+=(const OpCost &other)
+    {
+        moves += other.moves;
+        reallocations += other.reallocations;
+        hops += other.hops;
+        allocations += other.allocations;
+        return *this;
+    }
+
+    OpCost operator-(const OpCost &other) const
+    {
+        OpCost result;
+        result.moves = moves - other.moves;
+        result.reallocations = reallocations - other.reallocations;
+        result.hops = hops - other.hops;
+        result.allocations = allocations - other.allocations;
+        return result;
+    }
+};
+
+// 组件的一次操作：构造时记下模型计数器的当前值，析构时把差值记为本次开销并累加到总计
+// 模型的计数器只增不减，绘制时的查找也会计入，只有包在范围内的部分算作操作开销
+class OpCostScope
+{
+public:
+    OpCostScope(const OpCost &counter, OpCost &last, OpCost &total)
+        : counter(counter), last(last), total(total), before(counter) {}
+    ~OpCostScope()
+    {
+        last = counter - before;
+        total += last;
+    }
+
+private:
+    OpCostScope(const OpCostScope &);
+    OpCostScope &operator=(const OpCostScope &);
+
+    const OpCost &counter;
+    OpCost &last;
+    OpCost &total;
+    OpCost before;
+};
+
+#endif // OPCOST_H
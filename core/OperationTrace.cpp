@@ -0,0 +1,228 @@
+#include "OperationTrace.h"
+
+namespace {
+
+const char *const TRACE_HEADER = "# linear-trace 1\n";
+
+// 空值写成空记号时会在行尾被裁掉（或与相邻分隔符连在一起），用编码结果中不会单独出现的 % 表示
+const char *const EMPTY_VALUE_TOKEN = "%";
+
+// 字母、数字和 -._~ 原样保留，其余字节（包括空格和换行）编码，数值通常不需要编码
+QByteArray encodeValue(const QString &value)
+{
+    if (value.isEmpty()) {
+        return EMPTY_VALUE_TOKEN;
+    }
+    return value.toUtf8().toPercentEncoding();
+}
+
+QString decodeValue(const QByteArray &token)
+{
+    if (token == EMPTY_VALUE_TOKEN) {
+        return QString();
+    }
+    return QString::fromUtf8(QByteArray::fromPercentEncoding(token));
+}
+
+const char *typeName(TraceRecord::Type type)
+{
+    switch (type) {
+    case TraceRecord::Init:
+        return "init";
+    case TraceRecord::Insert:
+        return "insert";
+    case TraceRecord::Delete:
+        return "delete";
+    case TraceRecord::Modify:
+        return "modify";
+    }
+    return "";
+}
+
+const char *structureName(TraceRecord::Structure structure)
+{
+    switch (structure) {
+    case TraceRecord::Array:
+        return " a ";
+    case TraceRecord::LinkedList:
+        return " l ";
+    case TraceRecord::UnrolledList:
+        return " u ";
+    case TraceRecord::RingArray:
+        return " r ";
+    }
+    return " ";
+}
+
+bool parseType(const QByteArray &token, TraceRecord::Type &type)
+{
+    for (int t = TraceRecord::Init; t <= TraceRecord::Modify; ++t) {
+        if (token == typeName(static_cast<TraceRecord::Type>(t))) {
+            type = static_cast<TraceRecord::Type>(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseLine(const QByteArray &line, TraceRecord &record)
+{
+    QList<QByteArray> tokens = line.split(' ');
+    if (tokens.size() < 3) {
+        return false;
+    }
+
+    bool ok = false;
+    record.timeMs = tokens[0].toLongLong(&ok);
+    if (!ok || record.timeMs < 0) {
+        return false;
+    }
+
+    if (tokens[1] == "a") {
+        record.structure = TraceRecord::Array;
+    } else if (tokens[1] == "l") {
+        record.structure = TraceRecord::LinkedList;
+    } else if (tokens[1] == "u") {
+        record.structure = TraceRecord::UnrolledList;
+    } else if (tokens[1] == "r") {
+        record.structure = TraceRecord::RingArray;
+    } else {
+        return false;
+    }
+
+    if (!parseType(tokens[2], record.type)) {
+        return false;
+    }
+
+    record.values.clear();
+    if (record.type == TraceRecord::Init) {
+        for (int i = 3; i < tokens.size(); ++i) {
+            record.values << decodeValue(tokens[i]);
+        }
+        return true;
+    }
+
+    // 删除只有索引，插入和修改还有一个值
+    int expected = record.type == TraceRecord::Delete ? 4 : 5;
+    if (tokens.size() != expected) {
+        return false;
+    }
+    record.index = tokens[3].toInt(&ok);
+    if (!ok) {
+        return false;
+    }
+    if (expected == 5) {
+        record.values << decodeValue(tokens[4]);
+    }
+    return true;
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder()
+    : count(0)
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    close();
+}
+
+bool TraceRecorder::open(const QString &path)
+{
+    close();
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file.write(TRACE_HEADER);
+    file.flush();
+
+    count = 0;
+    clock.start();
+    return true;
+}
+
+void TraceRecorder::close()
+{
+    if (file.isOpen()) {
+        file.close();
+    }
+}
+
+void TraceRecorder::recordInit(TraceRecord::Structure structure, const QStringList &values)
+{
+    TraceRecord record;
+    record.structure = structure;
+    record.type = TraceRecord::Init;
+    record.values = values;
+    writeRecord(record);
+}
+
+void TraceRecorder::recordOperation(TraceRecord::Structure structure, TraceRecord::Type type, int index,
+                                    const QString &value)
+{
+    TraceRecord record;
+    record.structure = structure;
+    record.type = type;
+    record.index = index;
+    if (type != TraceRecord::Delete) {
+        record.values << value;
+    }
+    writeRecord(record);
+}
+
+void TraceRecorder::writeRecord(const TraceRecord &record)
+{
+    if (!file.isOpen()) {
+        return;
+    }
+
+    QByteArray line = QByteArray::number(clock.elapsed());
+    line += structureName(record.structure);
+    line += typeName(record.type);
+    if (record.type != TraceRecord::Init) {
+        line += ' ';
+        line += QByteArray::number(record.index);
+    }
+    for (const QString &value : record.values) {
+        line += ' ';
+        line += encodeValue(value);
+    }
+    line += '\n';
+
+    file.write(line);
+    file.flush();
+    ++count;
+}
+
+bool TraceRecorder::load(const QString &path, TraceRecordList &records, int &errorLine)
+{
+    records.clear();
+    errorLine = 0;
+
+    QFile input(path);
+    if (!input.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    int lineNumber = 0;
+    while (!input.atEnd()) {
+        QByteArray line = input.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith("#")) {
+            continue;
+        }
+
+        TraceRecord record;
+        if (!parseLine(line, record)) {
+            records.clear();
+            errorLine = lineNumber;
+            return false;
+        }
+        records.append(record);
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+#ifndef OPERATIONTRACE_H
+#define OPERATIONTRACE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QFile>
+#include <QElapsedTimer>
+
+// 操作轨迹中的一条记录：一次初始化、插入、删除或修改
+// 索引含义与界面组件的对应接口相同（插入时 index 表示在该索引之后，-1 表示开头，三种结构一致）
+struct TraceRecord {
+    enum Type {
+        Init,
+        Insert,
+        Delete,
+        Modify
+    };
+
+    enum Structure {
+        Array,
+        LinkedList,
+        UnrolledList,
+        RingArray  // 环形缓冲区模式的数组
+    };
+
+    qint64 timeMs;  // 相对录制开始的时刻
+    Structure structure;
+    Type type;
+    int index;  // 初始化时忽略
+    QStringList values;  // 初始化时为全部元素，插入和修改时只有一个值，删除时为空
+
+    TraceRecord() : timeMs(0), structure(Array), type(Init), index(0) {}
+};
+
+typedef QVector<TraceRecord> TraceRecordList;
+
+// 操作轨迹录制：每条记录写一行文本，值经过百分号编码，可以包含空格和换行；空值写为单独的 %
+//   <时刻ms> <a|l|u|r> <init|insert|delete|modify> [索引] [值...]
+// 每行写完立即刷新，程序异常退出时已录制的部分仍然可用
+class TraceRecorder
+{
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    bool open(const QString &path);  // 覆盖已有文件，失败时可通过 errorString() 查看原因
+    void close();
+    bool isRecording() const { return file.isOpen(); }
+    QString errorString() const { return file.errorString(); }
+    int recordCount() const { return count; }
+
+    void recordInit(TraceRecord::Structure structure, const QStringList &values);
+    void recordOperation(TraceRecord::Structure structure, TraceRecord::Type type, int index,
+                         const QString &value = QString());
+
+    // 读取整个轨迹文件；格式错误时返回 false，errorLine 为出错的行号（文件无法打开时为 0）
+    static bool load(const QString &path, TraceRecordList &records, int &errorLine);
+
+private:
+    void writeRecord(const TraceRecord &record);
+
+    QFile file;
+    QElapsedTimer clock;
+    int count;
+};
+
+#endif // OPERATIONTRACE_H
@@ -0,0 +1,106 @@
+#ifndef PACKEDFLAGS_H
+#define PACKEDFLAGS_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <QtAlgorithms>
+
+// 按位压缩的布尔列：每个标志 1 bit，按 64 位一个字存放
+// - count() 按字做 popcount，不逐个判断
+// - insert() 把后续位整体左移一位，开销 O(n/64)
+// 超出 size() 的高位始终为 0，count() 不需要屏蔽最后一个字
+class PackedFlags
+{
+public:
+    PackedFlags() : bitCount(0) {}
+
+    int size() const { return bitCount; }
+
+    void clear()
+    {
+        words.clear();
+        bitCount = 0;
+    }
+
+    // 新增的位为 0
+    void resize(int size)
+    {
+        words.resize((size + 63) / 64);
+        bitCount = size;
+        clearTail();
+    }
+
+    bool testBit(int index) const
+    {
+        return (words[index >> 6] >> (index & 63)) & 1;
+    }
+
+    void setBit(int index, bool on)
+    {
+        quint64 mask = quint64(1) << (index & 63);
+        if (on) {
+            words[index >> 6] |= mask;
+        } else {
+            words[index >> 6] &= ~mask;
+        }
+    }
+
+    void append(bool on)
+    {
+        if ((bitCount & 63) == 0) {
+            words.append(0);
+        }
+        ++bitCount;
+        setBit(bitCount - 1, on);
+    }
+
+    // 在 index 处插入一位，原来 [index, size) 的位后移
+    void insert(int index, bool on)
+    {
+        if ((bitCount & 63) == 0) {
+            words.append(0);
+        }
+        ++bitCount;
+
+        int word = index >> 6;
+        int bit = index & 63;
+        // 从最后一个字往前，每个字左移一位并接上前一个字的最高位
+        for (int w = words.size() - 1; w > word; --w) {
+            words[w] = (words[w] << 1) | (words[w - 1] >> 63);
+        }
+        quint64 low = words[word] & ((quint64(1) << bit) - 1);
+        quint64 high = bit < 63 ? (words[word] >> bit) << (bit + 1) : 0;
+        words[word] = low | high;
+        setBit(index, on);
+        clearTail();
+    }
+
+    int count() const
+    {
+        int total = 0;
+        for (int w = 0; w < words.size(); ++w) {
+            total += qPopulationCount(words[w]);
+        }
+        return total;
+    }
+
+    void swap(PackedFlags &other)
+    {
+        words.swap(other.words);
+        qSwap(bitCount, other.bitCount);
+    }
+
+private:
+    void clearTail()
+    {
+        int used = bitCount & 63;
+        if (used != 0) {
+            words.last() &= (quint64(1) << used) - 1;
+        }
+    }
+
+    QVector<quint64> words;
+    int bitCount;
+};
+
+#endif // PACKEDFLAGS_H
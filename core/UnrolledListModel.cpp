@@ -0,0 +1,387 @@
+#include "UnrolledListModel.h"
+
+namespace {
+
+const int HALF_CAPACITY = UnrolledNode::CAPACITY / 2;  // 拆分后每个节点的值个数，也是合并的阈值
+
+}
+
+UnrolledListModel::UnrolledListModel()
+    : headNode(nullptr)
+    , tailNode(nullptr)
+    , elementCount(0)
+    , nodeTotal(0)
+    , maxElementCount(DEFAULT_MAX_ELEMENTS)
+    , fingerNode(nullptr)
+    , fingerNodeIndex(0)
+    , fingerFirst(0)
+{
+}
+
+UnrolledListModel::~UnrolledListModel()
+{
+    clear();
+}
+
+void UnrolledListModel::clear()
+{
+    // 逐个归还值并析构节点后，整体回收节点池中的全部槽位
+    ValuePool &pool = ValuePool::shared();
+    UnrolledNode *current = headNode;
+    while (current) {
+        UnrolledNode *next = current->next;
+        for (int i = 0; i < current->count; ++i) {
+            pool.release(current->values[i]);
+        }
+        nodePool.discard(current);
+        current = next;
+    }
+    nodePool.reset();
+    headNode = nullptr;
+    tailNode = nullptr;
+    elementCount = 0;
+    nodeTotal = 0;
+    fingerNode = nullptr;
+    change = UnrolledChange();
+}
+
+void UnrolledListModel::reset(int size)
+{
+    clear();
+
+    if (size > maxElementCount) {
+        size = maxElementCount;  // 限制最大大小
+    }
+    for (int i = 0; i < size; ++i) {
+        if (!tailNode || tailNode->count == RESET_FILL) {
+            appendNode();
+        }
+        tailNode->values[tailNode->count++] = ValuePool::defaultLabel(i);
+    }
+    elementCount = qMax(0, size);
+}
+
+void UnrolledListModel::reset(const QStringList &values)
+{
+    clear();
+
+    int size = qMin(values.size(), maxElementCount);  // 限制最大大小
+    ValuePool &pool = ValuePool::shared();
+    for (int i = 0; i < size; ++i) {
+        if (!tailNode || tailNode->count == RESET_FILL) {
+            appendNode();
+        }
+        tailNode->values[tailNode->count++] = pool.acquire(values[i]);
+    }
+    elementCount = size;
+}
+
+UnrolledNode *UnrolledListModel::locate(int index, int &nodeIndex, int &slot)
+{
+    if (index < 0 || index >= elementCount) {
+        return nullptr;
+    }
+
+    // 末尾节点直接命中；否则从不超过目标的最近节点出发，逐个节点跳过
+    UnrolledNode *node = headNode;
+    int current = 0;
+    int first = 0;
+    if (index >= elementCount - tailNode->count) {
+        node = tailNode;
+        current = nodeTotal - 1;
+        first = elementCount - tailNode->count;
+    } else if (fingerNode && fingerFirst <= index) {
+        node = fingerNode;
+        current = fingerNodeIndex;
+        first = fingerFirst;
+    }
+
+    int start = current;
+    while (index >= first + node->count) {
+        first += node->count;
+        node = node->next;
+        ++current;
+    }
+    costCounter.hops += current - start;
+
+    remember(node, current, first);
+    nodeIndex = current;
+    slot = index - first;
+    return node;
+}
+
+UnrolledNode *UnrolledListModel::nodeAt(int nodeIndex, int &firstIndex)
+{
+    if (nodeIndex < 0 || nodeIndex >= nodeTotal) {
+        return nullptr;
+    }
+
+    UnrolledNode *node = headNode;
+    int current = 0;
+    int first = 0;
+    if (nodeIndex == nodeTotal - 1) {
+        node = tailNode;
+        current = nodeIndex;
+        first = elementCount - tailNode->count;
+    } else if (fingerNode && fingerNodeIndex <= nodeIndex) {
+        node = fingerNode;
+        current = fingerNodeIndex;
+        first = fingerFirst;
+    }
+
+    costCounter.hops += nodeIndex - current;
+    while (current < nodeIndex) {
+        first += node->count;
+        node = node->next;
+        ++current;
+    }
+
+    remember(node, current, first);
+    firstIndex = first;
+    return node;
+}
+
+QString UnrolledListModel::value(int index)
+{
+    int nodeIndex = 0;
+    int slot = 0;
+    UnrolledNode *node = locate(index, nodeIndex, slot);
+    return node ? valueOf(node, slot) : QString();
+}
+
+int UnrolledListModel::insertAfter(int index, const QString &value)
+{
+    // index = -1: 在开头插入
+    // index >= 0: 在索引index之后插入（如果index >= size，则在末尾插入）
+    if (index < -1 || elementCount >= maxElementCount) {
+        return -1;
+    }
+
+    change = UnrolledChange();
+    int insertIndex = index < 0 ? 0 : qMin(index + 1, elementCount);
+
+    UnrolledNode *node = nullptr;
+    int nodeIndex = 0;
+    int slot = 0;
+    if (insertIndex == elementCount) {
+        // 追加到末尾：末尾节点已满时直接新建节点，不拆分，顺序追加的节点都是满的
+        if (!tailNode || tailNode->count == UnrolledNode::CAPACITY) {
+            appendNode();
+        }
+        node = tailNode;
+        nodeIndex = nodeTotal - 1;
+        slot = node->count;
+    } else {
+        node = locate(insertIndex, nodeIndex, slot);
+    }
+    int first = insertIndex - slot;
+
+    if (node->count == UnrolledNode::CAPACITY) {
+        UnrolledNode *sibling = splitNode(node);
+        change.kind = UnrolledChange::Split;
+        change.node = nodeIndex;
+        if (slot > node->count) {
+            first += node->count;
+            slot -= node->count;
+            node = sibling;
+            ++nodeIndex;
+        }
+    }
+
+    for (int i = node->count; i > slot; --i) {
+        node->values[i] = node->values[i - 1];
+    }
+    costCounter.moves += node->count - slot;
+    node->values[slot] = ValuePool::shared().acquire(value);
+    node->count++;
+    elementCount++;
+
+    // 插入点之后的元素和节点序号都变了，只记住刚修改的节点
+    remember(node, nodeIndex, first);
+    return insertIndex;
+}
+
+int UnrolledListModel::insertRange(int index, const QStringList &values)
+{
+    // 每次插入后记住所在节点，下一次插入不需要从头定位
+    int inserted = 0;
+    int at = index;
+    for (const QString &value : values) {
+        at = insertAfter(at, value);
+        if (at < 0) {
+            break;  // 达到元素数量上限
+        }
+        ++inserted;
+    }
+    return inserted;
+}
+
+bool UnrolledListModel::removeAt(int index)
+{
+    int nodeIndex = 0;
+    int slot = 0;
+    UnrolledNode *node = locate(index, nodeIndex, slot);
+    if (!node) {
+        return false;
+    }
+
+    change = UnrolledChange();
+    ValuePool::shared().release(node->values[slot]);
+    for (int i = slot; i < node->count - 1; ++i) {
+        node->values[i] = node->values[i + 1];
+    }
+    costCounter.moves += node->count - 1 - slot;
+    node->count--;
+    elementCount--;
+
+    rebalance(node, nodeIndex);
+    return true;
+}
+
+int UnrolledListModel::removeRange(int index, int count)
+{
+    int removed = 0;
+    while (removed < count && removeAt(index)) {
+        ++removed;
+    }
+    return removed;
+}
+
+bool UnrolledListModel::modify(int index, const QString &value)
+{
+    int nodeIndex = 0;
+    int slot = 0;
+    UnrolledNode *node = locate(index, nodeIndex, slot);
+    if (!node) {
+        return false;
+    }
+    // 先取得新值再归还旧值，值不变时不会被回收后重新加入
+    ValuePool &pool = ValuePool::shared();
+    ValuePool::Handle handle = pool.acquire(value);
+    pool.release(node->values[slot]);
+    node->values[slot] = handle;
+    return true;
+}
+
+QStringList UnrolledListModel::values() const
+{
+    QStringList result;
+    result.reserve(elementCount);
+    for (UnrolledNode *node = headNode; node; node = node->next) {
+        for (int i = 0; i < node->count; ++i) {
+            result << valueOf(node, i);
+        }
+    }
+    return result;
+}
+
+void UnrolledListModel::setMaxElements(int limit)
+{
+    maxElementCount = qMax(1, limit);
+}
+
+UnrolledNode *UnrolledListModel::appendNode()
+{
+    UnrolledNode *node = nodePool.allocate();
+    costCounter.allocations++;
+    node->prev = tailNode;
+    if (tailNode) {
+        tailNode->next = node;
+    } else {
+        headNode = node;
+    }
+    tailNode = node;
+    nodeTotal++;
+    return node;
+}
+
+UnrolledNode *UnrolledListModel::splitNode(UnrolledNode *node)
+{
+    UnrolledNode *sibling = nodePool.allocate();
+    costCounter.allocations++;
+    for (int i = HALF_CAPACITY; i < node->count; ++i) {
+        sibling->values[i - HALF_CAPACITY] = node->values[i];
+    }
+    costCounter.moves += node->count - HALF_CAPACITY;
+    sibling->count = node->count - HALF_CAPACITY;
+    node->count = HALF_CAPACITY;
+
+    sibling->next = node->next;
+    sibling->prev = node;
+    if (node->next) {
+        node->next->prev = sibling;
+    } else {
+        tailNode = sibling;
+    }
+    node->next = sibling;
+    nodeTotal++;
+    return sibling;
+}
+
+void UnrolledListModel::rebalance(UnrolledNode *node, int nodeIndex)
+{
+    if (node->count >= HALF_CAPACITY) {
+        return;
+    }
+
+    UnrolledNode *next = node->next;
+    if (!next) {
+        // 最后一个节点允许不足半满，删空后回收
+        if (node->count == 0) {
+            unlinkTail(node);
+            change.kind = UnrolledChange::Remove;
+            change.node = nodeIndex;
+        }
+        return;
+    }
+
+    if (node->count + next->count <= UnrolledNode::CAPACITY) {
+        // 后继的值（连同句柄的引用）整体移入本节点
+        for (int i = 0; i < next->count; ++i) {
+            node->values[node->count + i] = next->values[i];
+        }
+        costCounter.moves += next->count;
+        node->count += next->count;
+        node->next = next->next;
+        if (next->next) {
+            next->next->prev = node;
+        } else {
+            tailNode = node;
+        }
+        nodePool.release(next);
+        nodeTotal--;
+        change.kind = UnrolledChange::Merge;
+    } else {
+        node->values[node->count++] = next->values[0];
+        for (int i = 0; i < next->count - 1; ++i) {
+            next->values[i] = next->values[i + 1];
+        }
+        costCounter.moves += next->count;  // 借出的一个加上后继中前移的 count - 1 个
+        next->count--;
+        change.kind = UnrolledChange::Borrow;
+    }
+    change.node = nodeIndex;
+}
+
+void UnrolledListModel::unlinkTail(UnrolledNode *node)
+{
+    // 前驱由节点本身得到，不需要从头遍历
+    tailNode = node->prev;
+    if (tailNode) {
+        tailNode->next = nullptr;
+    } else {
+        headNode = nullptr;
+    }
+    if (fingerNode == node) {
+        fingerNode = nullptr;
+    }
+    nodePool.release(node);
+    nodeTotal--;
+}
+
+void UnrolledListModel::remember(UnrolledNode *node, int nodeIndex, int firstIndex)
+{
+    fingerNode = node;
+    fingerNodeIndex = nodeIndex;
+    fingerFirst = firstIndex;
+}
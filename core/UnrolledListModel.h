@@ -0,0 +1,104 @@
+#ifndef UNROLLEDLISTMODEL_H
+#define UNROLLEDLISTMODEL_H
+
+#include <QString>
+#include <QStringList>
+#include "NodePool.h"
+#include "OpCost.h"
+#include "ValuePool.h"
+
+// 展开链表的节点：每个节点保存最多 CAPACITY 个值，节点内按顺序存放在 [0, count)
+// 节点之间双向链接，末尾节点删空后可以直接回到前驱
+struct UnrolledNode {
+    static const int CAPACITY = 8;
+
+    int count;
+    ValuePool::Handle values[CAPACITY];
+    UnrolledNode *next;
+    UnrolledNode *prev;  // 第一个节点没有前驱
+
+    UnrolledNode() : count(0), next(nullptr), prev(nullptr) {}
+};
+
+// 最近一次插入或删除引起的节点结构变化，界面据此提示拆分与合并
+struct UnrolledChange {
+    enum Kind {
+        None,
+        Split,   // 节点已满，后一半移到新节点 node+1
+        Merge,   // 节点不足半满，节点 node+1 的值全部并入节点 node 后被删除
+        Borrow,  // 节点不足半满但无法合并，从节点 node+1 借来一个值
+        Remove   // 最后一个节点被删空后回收
+    };
+
+    Kind kind;
+    int node;  // 发生变化的节点序号
+
+    UnrolledChange() : kind(None), node(-1) {}
+};
+
+// 展开链表数据模型（不依赖界面，只依赖 QtCore）
+// - 元素索引与链表一致：插入时 -1 表示开头，index 表示在索引 index 之后
+// - 按索引定位只需逐个节点跳过，开销 O(n/CAPACITY)
+// - 节点满时拆成两个半满节点；删除后不足半满时与后继合并或从后继借值
+class UnrolledListModel
+{
+public:
+    static const int DEFAULT_MAX_ELEMENTS = 1000000;  // 默认元素上限
+
+    UnrolledListModel();
+    ~UnrolledListModel();
+
+    void clear();
+    void reset(int size);  // 创建 size 个默认标签的元素（标签读取时才生成）
+    void reset(const QStringList &values);
+    int insertAfter(int index, const QString &value);  // 在索引index之后插入（-1 表示开头），返回新元素索引，失败返回 -1
+    int insertRange(int index, const QStringList &values);  // 依次在上一个插入的元素之后插入，返回插入个数
+    bool removeAt(int index);
+    int removeRange(int index, int count);  // 删除 [index, index+count) 的元素，返回删除个数
+    bool modify(int index, const QString &value);
+
+    // 定位索引为index的元素所在的节点、节点序号和节点内位置，不存在时返回 nullptr
+    UnrolledNode *locate(int index, int &nodeIndex, int &slot);
+    // 序号为nodeIndex的节点，firstIndex 为其第一个元素的索引
+    UnrolledNode *nodeAt(int nodeIndex, int &firstIndex);
+    QString valueOf(const UnrolledNode *node, int slot) const { return ValuePool::shared().value(node->values[slot]); }
+    QString value(int index);
+    int size() const { return elementCount; }
+    int nodeCount() const { return nodeTotal; }
+    QStringList values() const;
+    UnrolledChange lastChange() const { return change; }  // 最近一次插入或删除的结构变化
+    // 累计开销：节点内移动的值个数（moves）、跨节点走的步数（hops）和节点分配次数（allocations）
+    const OpCost &cost() const { return costCounter; }
+    NodePoolStats poolStats() const { return nodePool.stats(); }
+
+    void setMaxElements(int limit);
+    int maxElements() const { return maxElementCount; }
+
+private:
+    UnrolledListModel(const UnrolledListModel &);
+    UnrolledListModel &operator=(const UnrolledListModel &);
+
+    UnrolledNode *appendNode();  // 在末尾追加一个空节点
+    UnrolledNode *splitNode(UnrolledNode *node);  // 后一半移到新节点，返回新节点
+    void rebalance(UnrolledNode *node, int nodeIndex);  // 删除后处理不足半满的节点
+    void unlinkTail(UnrolledNode *node);  // 删除已经变空的最后一个节点，O(1)
+    void remember(UnrolledNode *node, int nodeIndex, int firstIndex);
+
+    UnrolledNode *headNode;
+    UnrolledNode *tailNode;
+    int elementCount;
+    int nodeTotal;
+    NodePool<UnrolledNode> nodePool;
+    int maxElementCount;
+    UnrolledChange change;
+    OpCost costCounter;
+
+    // 最近访问过的节点，按索引定位时若目标不在它之前则从它出发
+    UnrolledNode *fingerNode;
+    int fingerNodeIndex;
+    int fingerFirst;
+
+    static const int RESET_FILL = UnrolledNode::CAPACITY * 3 / 4;  // 初始化时每个节点的填充量，留出插入空间
+};
+
+#endif // UNROLLEDLISTMODEL_H
@@ -0,0 +1,72 @@
+#include "ValuePool.h"
+
+ValuePool &ValuePool::shared()
+{
+    static ValuePool pool;
+    return pool;
+}
+
+ValuePool::ValuePool()
+    : references(0)
+{
+    strings.append(QString());
+    refCounts.append(0);
+}
+
+ValuePool::Handle ValuePool::acquire(const QString &value)
+{
+    if (value.isEmpty()) {
+        return EMPTY_HANDLE;
+    }
+
+    Handle handle;
+    QHash<QString, Handle>::const_iterator it = lookup.constFind(value);
+    if (it != lookup.constEnd()) {
+        handle = it.value();
+    } else {
+        if (!freeHandles.isEmpty()) {
+            handle = freeHandles.last();
+            freeHandles.removeLast();
+            strings[handle] = value;
+        } else {
+            handle = Handle(strings.size());
+            strings.append(value);
+            refCounts.append(0);
+        }
+        lookup.insert(value, handle);
+    }
+
+    ++refCounts[handle];
+    ++references;
+    return handle;
+}
+
+void ValuePool::release(Handle handle)
+{
+    if (handle == EMPTY_HANDLE || (handle & DEFAULT_LABEL_FLAG)) {
+        return;
+    }
+
+    --references;
+    if (--refCounts[handle] == 0) {
+        lookup.remove(strings[handle]);
+        strings[handle] = QString();
+        freeHandles.append(handle);
+    }
+}
+
+QString ValuePool::value(Handle handle) const
+{
+    if (handle & DEFAULT_LABEL_FLAG) {
+        return QString("节点%1").arg(int(handle & ~DEFAULT_LABEL_FLAG));
+    }
+    return strings[handle];
+}
+
+ValuePoolStats ValuePool::stats() const
+{
+    ValuePoolStats result;
+    result.uniqueValues = lookup.size();
+    result.references = references;
+    return result;
+}
@@ -0,0 +1,53 @@
+#ifndef VALUEPOOL_H
+#define VALUEPOOL_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QtGlobal>
+
+// 值池统计信息
+struct ValuePoolStats {
+    int uniqueValues;   // 池中不同值的个数
+    qint64 references;  // 元素持有的句柄总数（不含空值和默认标签）
+
+    ValuePoolStats() : uniqueValues(0), references(0) {}
+
+    double dedupRatio() const { return uniqueValues > 0 ? double(references) / uniqueValues : 1.0; }
+};
+
+// 元素值的驻留池：相同的值只保存一份，元素通过 32 位句柄引用并计数
+// - 句柄 0 表示空字符串，不占用池中的槽位
+// - 最高位为 1 的句柄是默认标签（"节点N"），低位保存编号，读取时才生成文本
+// 数组和链表模型共用 shared() 实例；只能在界面线程中使用
+class ValuePool
+{
+public:
+    typedef quint32 Handle;
+
+    static const Handle EMPTY_HANDLE = 0;
+    static const Handle DEFAULT_LABEL_FLAG = 0x80000000u;
+
+    static ValuePool &shared();
+    static Handle defaultLabel(int number) { return DEFAULT_LABEL_FLAG | Handle(number); }
+
+    ValuePool();
+
+    Handle acquire(const QString &value);  // 查找或加入值，引用计数加一
+    void release(Handle handle);  // 引用计数减一，归零时回收槽位
+    QString value(Handle handle) const;
+
+    ValuePoolStats stats() const;
+
+private:
+    ValuePool(const ValuePool &);
+    ValuePool &operator=(const ValuePool &);
+
+    QVector<QString> strings;  // 下标即句柄，0 号槽位保留给空值
+    QVector<int> refCounts;
+    QVector<Handle> freeHandles;  // 已回收的槽位
+    QHash<QString, Handle> lookup;
+    qint64 references;
+};
+
+#endif // VALUEPOOL_H
@@ -0,0 +1,653 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include <QRegExp>
+#include <QTemporaryDir>
+#include "ArrayModel.h"
+#include "LinkedListModel.h"
+#include "UnrolledListModel.h"
+#include "InputTokenizer.h"
+#include "OperationTrace.h"
+
+namespace {
+
+const int ROUNDS = 200;  // 每种结构的随机操作序列个数
+const int STEPS = 150;   // 每个序列的操作次数
+
+// 随机值都不为空，数组参照模型中的空字符串因此可以表示空位置
+QString randomValue(QRandomGenerator &random)
+{
+    return QString("v%1").arg(random.bounded(50));
+}
+
+QStringList randomValues(QRandomGenerator &random, int maxCount)
+{
+    QStringList values;
+    int count = random.bounded(maxCount + 1);
+    for (int i = 0; i < count; ++i) {
+        values << randomValue(random);
+    }
+    return values;
+}
+
+// 包括 -2 和越过末尾的非法索引
+int randomIndex(QRandomGenerator &random, int size)
+{
+    return random.bounded(size + 4) - 2;
+}
+
+// 数组的参照模型：positions 按逻辑索引保存值，空字符串为空位置
+struct ArrayOracle {
+    QStringList positions;
+    int maxElements;
+    bool ring;
+
+    ArrayOracle() : maxElements(0), ring(false) {}
+
+    int insert(int index, const QString &value)
+    {
+        if (index < -1) {
+            return -1;
+        }
+        int position = index < 0 ? 0 : qMin(index + 1, positions.size());
+        if (position < positions.size() && positions[position].isEmpty()) {
+            positions[position] = value;  // 优先填充空位置
+            return position;
+        }
+        if (positions.size() >= maxElements) {
+            return -1;
+        }
+        positions.insert(position, value);
+        return position;
+    }
+
+    bool erase(int index)
+    {
+        if (index < 0 || index >= positions.size() || positions[index].isEmpty()) {
+            return false;
+        }
+        if (ring && (index == 0 || index == positions.size() - 1)) {
+            positions.removeAt(index);  // 环形模式下两端的位置一起移除
+        } else {
+            positions[index].clear();
+        }
+        return true;
+    }
+
+    int eraseRange(int index, int count, int &frontPopped)
+    {
+        int erased = 0;
+        int position = qMax(0, index);
+        frontPopped = 0;
+        for (int remaining = qMin(index + count, positions.size()) - position; remaining > 0; --remaining) {
+            int oldSize = positions.size();
+            if (erase(position)) {
+                ++erased;
+            }
+            if (positions.size() == oldSize) {
+                ++position;
+            } else if (position == 0) {
+                ++frontPopped;
+            }
+        }
+        return erased;
+    }
+
+    bool modify(int index, const QString &value)
+    {
+        if (index < 0 || index >= positions.size() || positions[index].isEmpty()) {
+            return false;
+        }
+        positions[index] = value;
+        return true;
+    }
+};
+
+// 链表和展开链表的参照模型
+int oracleInsertAfter(QStringList &list, int maxElements, int index, const QString &value)
+{
+    if (index < -1 || list.size() >= maxElements) {
+        return -1;
+    }
+    int position = index < 0 ? 0 : qMin(index + 1, list.size());
+    list.insert(position, value);
+    return position;
+}
+
+int oracleRemoveRange(QStringList &list, int index, int count)
+{
+    int removed = 0;
+    if (index >= 0) {
+        while (removed < count && index < list.size()) {
+            list.removeAt(index);
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+// 原来的输入解析：按正则切分后截取前 limit 个
+QStringList oldTokenize(const QString &text, int limit)
+{
+    return text.split(QRegExp("\\s+"), QString::SkipEmptyParts).mid(0, limit);
+}
+
+} // namespace
+
+class LinearCoreTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    void verifyArray(const ArrayModel &model, const ArrayOracle &oracle);
+    void verifyLinkedList(LinkedListModel &model, const QStringList &oracle);
+    void verifyUnrolledList(UnrolledListModel &model, const QStringList &oracle);
+    void runArray(bool ring);
+
+private slots:
+    void init();
+    void cleanup();
+
+    void arrayMatchesOracle();
+    void ringArrayMatchesOracle();
+    void arrayOccupancyAcrossWords();
+    void linkedListMatchesOracle();
+    void unrolledListMatchesOracle();
+    void valuePoolSharesEqualValues();
+
+    void tokenizerMatchesOldParser_data();
+    void tokenizerMatchesOldParser();
+    void tokenizerRandomText();
+
+    void traceRoundTrip();
+    void traceRejectsMalformedLine();
+
+private:
+    ValuePoolStats poolBefore;
+};
+
+void LinearCoreTest::init()
+{
+    poolBefore = ValuePool::shared().stats();
+}
+
+void LinearCoreTest::cleanup()
+{
+    // 模型析构后归还全部引用，共用值池回到测试前的状态
+    ValuePoolStats poolAfter = ValuePool::shared().stats();
+    QCOMPARE(poolAfter.references, poolBefore.references);
+    QCOMPARE(poolAfter.uniqueValues, poolBefore.uniqueValues);
+}
+
+void LinearCoreTest::verifyArray(const ArrayModel &model, const ArrayOracle &oracle)
+{
+    QCOMPARE(model.size(), oracle.positions.size());
+    if (!model.isRingMode()) {
+        QCOMPARE(model.capacity(), model.size());
+    }
+    int filled = 0;
+    for (int i = 0; i < oracle.positions.size(); ++i) {
+        bool empty = oracle.positions[i].isEmpty();
+        QCOMPARE(model.isEmpty(i), empty);
+        QCOMPARE(model.value(i), oracle.positions[i]);
+        QCOMPARE(model.logicalIndex(model.physicalIndex(i)), i);
+        if (!empty) {
+            ++filled;
+        }
+    }
+    QCOMPARE(model.count(), filled);
+}
+
+void LinearCoreTest::verifyLinkedList(LinkedListModel &model, const QStringList &oracle)
+{
+    QCOMPARE(model.size(), oracle.size());
+    QCOMPARE(model.values(), oracle);
+
+    // 沿后继走一遍，检查前驱和尾指针
+    int index = 0;
+    ListNode *previous = model.head();
+    for (ListNode *node = previous ? previous->next : nullptr; node; node = node->next) {
+        QVERIFY(node->prev == previous);
+        QCOMPARE(model.valueOf(node), oracle[index]);
+        previous = node;
+        ++index;
+    }
+    QCOMPARE(index, oracle.size());
+    QVERIFY(model.tail() == (oracle.isEmpty() ? nullptr : previous));
+
+    for (int i = 0; i < oracle.size(); ++i) {
+        QCOMPARE(model.value(i), oracle[i]);
+    }
+}
+
+void LinearCoreTest::verifyUnrolledList(UnrolledListModel &model, const QStringList &oracle)
+{
+    QCOMPARE(model.size(), oracle.size());
+    QCOMPARE(model.values(), oracle);
+
+    // 除最后一个节点外都至少半满，相邻节点互相链接
+    int nodes = model.nodeCount();
+    int total = 0;
+    UnrolledNode *previous = nullptr;
+    for (int k = 0; k < nodes; ++k) {
+        int first = -1;
+        UnrolledNode *node = model.nodeAt(k, first);
+        QVERIFY(node);
+        QCOMPARE(first, total);
+        QVERIFY(node->prev == previous);
+        QVERIFY(node->count >= 1 && node->count <= UnrolledNode::CAPACITY);
+        if (k < nodes - 1) {
+            QVERIFY(node->count >= UnrolledNode::CAPACITY / 2);
+            QVERIFY(node->next);
+        } else {
+            QVERIFY(!node->next);
+        }
+        total += node->count;
+        previous = node;
+    }
+    QCOMPARE(total, oracle.size());
+
+    for (int i = 0; i < oracle.size(); ++i) {
+        QCOMPARE(model.value(i), oracle[i]);
+    }
+}
+
+void LinearCoreTest::runArray(bool ring)
+{
+    QRandomGenerator random(ring ? 11 : 7);
+    for (int round = 0; round < ROUNDS; ++round) {
+        ArrayModel model;
+        ArrayOracle oracle;
+        oracle.maxElements = 5 + random.bounded(60);
+        oracle.ring = ring;
+        model.setMaxElements(oracle.maxElements);
+
+        QStringList initial = randomValues(random, 20);
+        model.reset(initial);
+        model.setRingMode(ring);
+        oracle.positions = initial.mid(0, oracle.maxElements);
+        if (initial.isEmpty()) {
+            for (int i = 0; i < 5; ++i) {
+                oracle.positions << QString();  // 空列表初始化为 5 个空位置
+            }
+        }
+
+        for (int step = 0; step < STEPS; ++step) {
+            int size = oracle.positions.size();
+            int index = randomIndex(random, size);
+            switch (random.bounded(6)) {
+            case 0: {
+                QString value = randomValue(random);
+                QCOMPARE(model.insert(index, value), oracle.insert(index, value));
+                break;
+            }
+            case 1: {
+                // 两端插入和删除覆盖环形模式的出队入队
+                int end = random.bounded(2) ? -1 : size - 1;
+                QString value = randomValue(random);
+                QCOMPARE(model.insert(end, value), oracle.insert(end, value));
+                QCOMPARE(model.erase(0), oracle.erase(0));
+                break;
+            }
+            case 2:
+                QCOMPARE(model.erase(index), oracle.erase(index));
+                break;
+            case 3: {
+                QString value = randomValue(random);
+                QCOMPARE(model.modify(index, value), oracle.modify(index, value));
+                break;
+            }
+            case 4: {
+                QStringList values = randomValues(random, 5);
+                int expected = 0;
+                int at = index;
+                for (const QString &value : values) {
+                    at = oracle.insert(at, value);
+                    if (at < 0) {
+                        break;
+                    }
+                    ++expected;
+                }
+                QCOMPARE(model.insertRange(index, values), expected);
+                break;
+            }
+            default: {
+                int count = random.bounded(6);
+                int expectedFront = 0;
+                int expected = oracle.eraseRange(index, count, expectedFront);
+                int frontPopped = -1;
+                QCOMPARE(model.eraseRange(index, count, &frontPopped), expected);
+                QCOMPARE(frontPopped, expectedFront);
+                break;
+            }
+            }
+            verifyArray(model, oracle);
+            if (QTest::currentTestFailed()) {
+                qWarning("round %d step %d", round, step);
+                return;
+            }
+        }
+    }
+}
+
+void LinearCoreTest::arrayMatchesOracle()
+{
+    runArray(false);
+}
+
+void LinearCoreTest::ringArrayMatchesOracle()
+{
+    runArray(true);
+}
+
+void LinearCoreTest::arrayOccupancyAcrossWords()
+{
+    // 占用标志按 64 位一个字存放，填充、插入和清空都跨越字的边界
+    ArrayModel model;
+    model.reset(130);
+    QCOMPARE(model.count(), 0);
+
+    // 在索引 i - 1 之后插入会填充空位置 i，不新增位置
+    for (int i = 0; i < 130; i += 3) {
+        QCOMPARE(model.insert(i - 1, QString("v%1").arg(i)), i);
+    }
+    QCOMPARE(model.size(), 130);
+    QCOMPARE(model.count(), 44);
+
+    // 位置 0 已占用，在开头新增位置，其后的标志整体后移一位
+    QCOMPARE(model.insert(-1, QString("front")), 0);
+    QCOMPARE(model.size(), 131);
+    QCOMPARE(model.count(), 45);
+    for (int i = 1; i < model.size(); ++i) {
+        QCOMPARE(model.isEmpty(i), (i - 1) % 3 != 0);
+    }
+
+    QVERIFY(model.erase(64));
+    QVERIFY(model.isEmpty(64));
+    QVERIFY(!model.erase(64));
+    QCOMPARE(model.count(), 44);
+    QCOMPARE(model.values().size(), 44);
+    QCOMPARE(model.values().first(), QString("front"));
+    QCOMPARE(model.values().last(), QString("v129"));
+}
+
+void LinearCoreTest::linkedListMatchesOracle()
+{
+    QRandomGenerator random(13);
+    for (int round = 0; round < ROUNDS; ++round) {
+        LinkedListModel model;
+        int maxElements = 5 + random.bounded(60);
+        model.setMaxElements(maxElements);
+        QStringList initial = randomValues(random, 20);
+        model.reset(initial);
+        QStringList oracle = initial.mid(0, maxElements);
+
+        for (int step = 0; step < STEPS; ++step) {
+            int index = randomIndex(random, oracle.size());
+            switch (random.bounded(5)) {
+            case 0: {
+                QString value = randomValue(random);
+                QCOMPARE(model.insertAfter(index, value), oracleInsertAfter(oracle, maxElements, index, value));
+                break;
+            }
+            case 1: {
+                bool valid = index >= 0 && index < oracle.size();
+                QCOMPARE(model.removeAt(index), valid);
+                if (valid) {
+                    oracle.removeAt(index);
+                }
+                break;
+            }
+            case 2: {
+                QString value = randomValue(random);
+                bool valid = index >= 0 && index < oracle.size();
+                QCOMPARE(model.modify(index, value), valid);
+                if (valid) {
+                    oracle[index] = value;
+                }
+                break;
+            }
+            case 3: {
+                QStringList values = randomValues(random, 5);
+                int expected = 0;
+                int at = index;
+                for (const QString &value : values) {
+                    at = oracleInsertAfter(oracle, maxElements, at, value);
+                    if (at < 0) {
+                        break;
+                    }
+                    ++expected;
+                }
+                QCOMPARE(model.insertRange(index, values), expected);
+                break;
+            }
+            default: {
+                int count = random.bounded(6);
+                QCOMPARE(model.removeRange(index, count), oracleRemoveRange(oracle, index, count));
+                break;
+            }
+            }
+            verifyLinkedList(model, oracle);
+            if (QTest::currentTestFailed()) {
+                qWarning("round %d step %d", round, step);
+                return;
+            }
+        }
+    }
+}
+
+void LinearCoreTest::unrolledListMatchesOracle()
+{
+    QRandomGenerator random(17);
+    for (int round = 0; round < ROUNDS; ++round) {
+        UnrolledListModel model;
+        int maxElements = 5 + random.bounded(80);
+        model.setMaxElements(maxElements);
+        QStringList initial = randomValues(random, 30);
+        model.reset(initial);
+        QStringList oracle = initial.mid(0, maxElements);
+
+        for (int step = 0; step < STEPS; ++step) {
+            int index = randomIndex(random, oracle.size());
+            switch (random.bounded(5)) {
+            case 0: {
+                QString value = randomValue(random);
+                QCOMPARE(model.insertAfter(index, value), oracleInsertAfter(oracle, maxElements, index, value));
+                break;
+            }
+            case 1: {
+                bool valid = index >= 0 && index < oracle.size();
+                QCOMPARE(model.removeAt(index), valid);
+                if (valid) {
+                    oracle.removeAt(index);
+                }
+                break;
+            }
+            case 2: {
+                QString value = randomValue(random);
+                bool valid = index >= 0 && index < oracle.size();
+                QCOMPARE(model.modify(index, value), valid);
+                if (valid) {
+                    oracle[index] = value;
+                }
+                break;
+            }
+            case 3: {
+                QStringList values = randomValues(random, 12);
+                int expected = 0;
+                int at = index;
+                for (const QString &value : values) {
+                    at = oracleInsertAfter(oracle, maxElements, at, value);
+                    if (at < 0) {
+                        break;
+                    }
+                    ++expected;
+                }
+                QCOMPARE(model.insertRange(index, values), expected);
+                break;
+            }
+            default: {
+                int count = random.bounded(12);
+                QCOMPARE(model.removeRange(index, count), oracleRemoveRange(oracle, index, count));
+                break;
+            }
+            }
+            verifyUnrolledList(model, oracle);
+            if (QTest::currentTestFailed()) {
+                qWarning("round %d step %d", round, step);
+                return;
+            }
+        }
+    }
+}
+
+void LinearCoreTest::valuePoolSharesEqualValues()
+{
+    // 两种结构中相同的值共用一个槽位，引用计数随元素增减
+    ArrayModel array;
+    LinkedListModel list;
+    array.reset(QStringList() << "same" << "other" << "same");
+    list.reset(QStringList() << "same");
+    ValuePoolStats stats = ValuePool::shared().stats();
+    QCOMPARE(stats.uniqueValues - poolBefore.uniqueValues, 2);
+    QCOMPARE(stats.references - poolBefore.references, qint64(4));
+
+    // 最后一个引用被替换后槽位回收
+    QVERIFY(array.modify(1, "same"));
+    stats = ValuePool::shared().stats();
+    QCOMPARE(stats.uniqueValues - poolBefore.uniqueValues, 1);
+    QCOMPARE(stats.references - poolBefore.references, qint64(4));
+
+    QVERIFY(list.removeAt(0));
+    stats = ValuePool::shared().stats();
+    QCOMPARE(stats.references - poolBefore.references, qint64(3));
+
+    // 空值和默认标签不占用槽位
+    list.reset(3);
+    QCOMPARE(list.insertAfter(-1, QString()), 0);
+    QCOMPARE(list.value(0), QString());
+    QCOMPARE(list.value(1), QString("节点0"));
+    stats = ValuePool::shared().stats();
+    QCOMPARE(stats.uniqueValues - poolBefore.uniqueValues, 1);
+    QCOMPARE(stats.references - poolBefore.references, qint64(3));
+}
+
+void LinearCoreTest::tokenizerMatchesOldParser_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("limit");
+
+    QTest::newRow("empty") << QString() << 10;
+    QTest::newRow("spaces only") << QString("   \t\n  ") << 10;
+    QTest::newRow("single") << QString("42") << 10;
+    QTest::newRow("leading and trailing") << QString("  1 2  3 ") << 10;
+    QTest::newRow("mixed whitespace") << QString("1\t2\n3\r\n4\v5\f6") << 10;
+    QTest::newRow("long tokens") << QString("abcdefghijk lmnopqrstuvwxyz 0123456789abcdef") << 10;
+    QTest::newRow("non-ascii") << QString::fromUtf8("节点一 节点二\xE3\x80\x80节点三") << 10;
+    QTest::newRow("nbsp and nel") << QString::fromUtf8("a\xC2\xA0" "b\xC2\x85" "c") << 10;
+    QTest::newRow("limit reached") << QString("1 2 3 4 5 6 7 8 9 10 11 12") << 5;
+    QTest::newRow("limit zero") << QString("1 2 3") << 0;
+}
+
+void LinearCoreTest::tokenizerMatchesOldParser()
+{
+    QFETCH(QString, text);
+    QFETCH(int, limit);
+
+    QStringList expected = oldTokenize(text, limit);
+    QCOMPARE(InputTokenizer::tokenize(QStringView(text), limit), expected);
+    QCOMPARE(InputTokenizer::count(QStringView(text), limit), expected.size());
+}
+
+void LinearCoreTest::tokenizerRandomText()
+{
+    // 空白与非空白、ASCII 与非 ASCII 混合，覆盖按 8 个字符一组扫描的各种边界
+    const ushort alphabet[] = { 'a', '7', ' ', ' ', '\t', '\n', '\r', 0x00A0, 0x3000, 0x8282 };
+    const int alphabetSize = int(sizeof(alphabet) / sizeof(alphabet[0]));
+    QRandomGenerator random(19);
+    for (int round = 0; round < 500; ++round) {
+        QString text;
+        int length = random.bounded(80);
+        for (int i = 0; i < length; ++i) {
+            text += QChar(alphabet[random.bounded(alphabetSize)]);
+        }
+        int limit = random.bounded(40);
+
+        QStringList expected = oldTokenize(text, limit);
+        QCOMPARE(InputTokenizer::tokenize(QStringView(text), limit), expected);
+        QCOMPARE(InputTokenizer::count(QStringView(text), limit), expected.size());
+    }
+}
+
+void LinearCoreTest::traceRoundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("trace.txt");
+
+    QStringList initValues;
+    initValues << "1" << "two words" << "line\nbreak" << QString() << "%" << QString::fromUtf8("节点");
+
+    TraceRecorder recorder;
+    QVERIFY(recorder.open(path));
+    recorder.recordInit(TraceRecord::Array, initValues);
+    recorder.recordInit(TraceRecord::LinkedList, QStringList());
+    recorder.recordOperation(TraceRecord::LinkedList, TraceRecord::Insert, -1, QString());
+    recorder.recordOperation(TraceRecord::UnrolledList, TraceRecord::Delete, 3);
+    recorder.recordOperation(TraceRecord::RingArray, TraceRecord::Modify, 0, "a b\tc");
+    QCOMPARE(recorder.recordCount(), 5);
+    recorder.close();
+
+    TraceRecordList records;
+    int errorLine = -1;
+    QVERIFY(TraceRecorder::load(path, records, errorLine));
+    QCOMPARE(errorLine, 0);
+    QCOMPARE(records.size(), 5);
+
+    QCOMPARE(records[0].structure, TraceRecord::Array);
+    QCOMPARE(records[0].type, TraceRecord::Init);
+    QCOMPARE(records[0].values, initValues);
+
+    QCOMPARE(records[1].structure, TraceRecord::LinkedList);
+    QCOMPARE(records[1].type, TraceRecord::Init);
+    QVERIFY(records[1].values.isEmpty());
+
+    QCOMPARE(records[2].type, TraceRecord::Insert);
+    QCOMPARE(records[2].index, -1);
+    QCOMPARE(records[2].values, QStringList(QString()));
+
+    QCOMPARE(records[3].structure, TraceRecord::UnrolledList);
+    QCOMPARE(records[3].type, TraceRecord::Delete);
+    QCOMPARE(records[3].index, 3);
+    QVERIFY(records[3].values.isEmpty());
+
+    QCOMPARE(records[4].structure, TraceRecord::RingArray);
+    QCOMPARE(records[4].type, TraceRecord::Modify);
+    QCOMPARE(records[4].index, 0);
+    QCOMPARE(records[4].values, QStringList("a b\tc"));
+
+    for (int i = 1; i < records.size(); ++i) {
+        QVERIFY(records[i].timeMs >= records[i - 1].timeMs);
+    }
+}
+
+void LinearCoreTest::traceRejectsMalformedLine()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("broken.txt");
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("# linear-trace 1\n0 a init 1 2\n5 a insert 1\n");  // 插入缺少值
+    file.close();
+
+    TraceRecordList records;
+    int errorLine = 0;
+    QVERIFY(!TraceRecorder::load(path, records, errorLine));
+    QCOMPARE(errorLine, 3);
+    QVERIFY(records.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(LinearCoreTest)
+
+#include "tst_linearcore.moc"